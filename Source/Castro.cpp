@@ -7,6 +7,7 @@
 #include <iomanip>
 
 #include <algorithm>
+#include <limits>
 #include <cstdio>
 #include <vector>
 #include <iostream>
@@ -57,6 +58,11 @@ int          Castro::NUM_GROW      = -1;
 
 Real         Castro::frac_change   = 1.e200;
 
+int          Castro::num_retries         = 0;
+int          Castro::num_retry_forecasts = 0;
+Real         Castro::retry_wasted_zones  = 0.0;
+Real         Castro::retry_total_zones   = 0.0;
+
 int          Castro::Density       = -1;
 int          Castro::Eden          = -1;
 int          Castro::Eint          = -1;
@@ -111,6 +117,7 @@ Radiation*   Castro::radiation = 0;
 
 
 std::string  Castro::probin_file = "probin";
+Array<std::string> Castro::plot_lossy_vars;
 
 
 #if BL_SPACEDIM == 1
@@ -172,6 +179,8 @@ Castro::variableCleanUp ()
   TracerPC = 0;
 #endif
 
+    hydro_scratch.clear();
+
     desc_lst.clear();
 }
 
@@ -321,6 +330,20 @@ Castro::read_params ()
         BoxLib::Error();
       }
 
+    if (riemann_solver == 3 && BL_SPACEDIM != 3)
+      {
+        std::cerr << "riemann_solver = 3 only implemented in 3-d\n";
+        BoxLib::Error();
+      }
+
+#ifdef RADIATION
+    if (riemann_solver == 3)
+      {
+        std::cerr << "riemann_solver = 3 not implemented for radiation\n";
+        BoxLib::Error();
+      }
+#endif
+
     if (use_colglaz >= 0)
       {
 	std::cerr << "ERROR:: use_colglaz is deprecated.  Use riemann_solver instead\n";
@@ -381,6 +404,10 @@ Castro::read_params ()
 	for (int i=0; i<BL_SPACEDIM; i++) hydro_tile_size[i] = tilesize[i];
     }
 
+    int nlossy = pp.countval("plot_lossy_vars");
+    if (nlossy > 0)
+	pp.getarr("plot_lossy_vars", plot_lossy_vars, 0, nlossy);
+
 }
 
 Castro::Castro ()
@@ -396,6 +423,9 @@ Castro::Castro ()
     new_sources(num_src, PArrayManage),
     prev_state(num_state_type, PArrayManage)
 {
+#if defined(REACTIONS) && !defined(SDC)
+    burn_data_stale[0] = burn_data_stale[1] = true;
+#endif
 }
 
 Castro::Castro (Amr&            papa,
@@ -416,6 +446,10 @@ Castro::Castro (Amr&            papa,
     new_sources(num_src, PArrayManage),
     prev_state(num_state_type, PArrayManage)
 {
+#if defined(REACTIONS) && !defined(SDC)
+    burn_data_stale[0] = burn_data_stale[1] = true;
+#endif
+
     buildMetrics();
 
     initMFs();
@@ -557,6 +591,8 @@ Castro::Castro (Amr&            papa,
 
 Castro::~Castro ()
 {
+    clear_fill_patch_cache();
+
 #ifdef RADIATION
     if (radiation != 0) {
       //radiation->cleanup(level);
@@ -1072,209 +1108,172 @@ Castro::estTimeStep (Real dt_old)
 
     std::string limiter = "castro.max_dt";
 
+    // The hydro, temperature diffusion, enthalpy diffusion and burning
+    // limiters are all evaluated in one sweep over the zones, and
+    // reduced together.
+
+    const int n_dt = 4;
+    const char* dt_names[n_dt] = { "hydro", "temperature diffusion", "enthalpy diffusion", "burning" };
+
+    int do_dt[n_dt] = { 0, 0, 0, 0 };
+
     // Start the hydro with the max_dt value, but divide by CFL
     // to account for the fact that we multiply by it at the end.
     // This ensures that if max_dt is more restrictive than the hydro
     // criterion, we will get exactly max_dt for a timestep.
+    // Note that the diffusion uses the same CFL safety factor
+    // as the main hydrodynamics timestep limiter.
 
-    Real estdt_hydro = max_dt / cfl;
+    Real dt_lim[n_dt] = { max_dt / cfl, max_dt / cfl, max_dt / cfl, max_dt };
+
+    // The zone that set each limit on this processor.
+
+    int dt_loc[3*n_dt];
+    for (int n = 0; n < 3*n_dt; ++n)
+	dt_loc[n] = -1;
 
 #ifdef DIFFUSION
-    if (do_hydro or diffuse_temp or diffuse_enth)
+    const bool hydro_dt = do_hydro or diffuse_temp or diffuse_enth;
 #else
-    if (do_hydro)
+    const bool hydro_dt = do_hydro;
 #endif
-    {
+
+    bool rad_hydro_combined = false;
 
 #ifdef RADIATION
-      if (Radiation::rad_hydro_combined) {
+    rad_hydro_combined = Radiation::rad_hydro_combined;
+
+    if (rad_hydro_combined && hydro_dt) {
 
-	  // Compute radiation + hydro limited timestep.
+	// Compute radiation + hydro limited timestep.
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-	  {
-	      Real dt = max_dt / cfl;
+	{
+	    Real dt = max_dt / cfl;
 
-	      const MultiFab& radMF = get_new_data(Rad_Type);
-	      FArrayBox gPr;
+	    const MultiFab& radMF = get_new_data(Rad_Type);
+	    FArrayBox gPr;
 
-	      for (MFIter mfi(stateMF, true); mfi.isValid(); ++mfi)
-	      {
-	          const Box& tbox = mfi.tilebox();
-	          const Box& vbox = mfi.validbox();
+	    for (MFIter mfi(stateMF, true); mfi.isValid(); ++mfi)
+	    {
+		const Box& tbox = mfi.tilebox();
+		const Box& vbox = mfi.validbox();
 
-		  gPr.resize(tbox);
-		  radiation->estimate_gamrPr(stateMF[mfi], radMF[mfi], gPr, dx, vbox);
+		gPr.resize(tbox);
+		radiation->estimate_gamrPr(stateMF[mfi], radMF[mfi], gPr, dx, vbox);
 
-		  ca_estdt_rad(BL_TO_FORTRAN(stateMF[mfi]),
-			       BL_TO_FORTRAN(gPr),
-			       tbox.loVect(),tbox.hiVect(),dx,&dt);
-              }
+		ca_estdt_rad(BL_TO_FORTRAN(stateMF[mfi]),
+			     BL_TO_FORTRAN(gPr),
+			     tbox.loVect(),tbox.hiVect(),dx,&dt);
+	    }
 #ifdef _OPENMP
 #pragma omp critical (castro_estdt_rad)
 #endif
-	      {
-	          estdt_hydro = std::min(estdt_hydro,dt);
-              }
-          }
-      }
-      else
-      {
+	    {
+		dt_lim[0] = std::min(dt_lim[0],dt);
+	    }
+	}
+    }
 #endif
 
-	  // Compute hydro-limited timestep.
-	if (do_hydro)
-	  {
-
-#ifdef _OPENMP
-#pragma omp parallel
+    if (!rad_hydro_combined) {
+	do_dt[0] = do_hydro;
+#ifdef DIFFUSION
+	do_dt[1] = diffuse_temp;
+	do_dt[2] = diffuse_enth;
 #endif
-	    {
-	      Real dt = max_dt / cfl;
+    }
 
-	      for (MFIter mfi(stateMF,true); mfi.isValid(); ++mfi)
-		{
-		  const Box& box = mfi.tilebox();
+    const MultiFab* S_old = &stateMF;
 
-		  ca_estdt(ARLIM_3D(box.loVect()), ARLIM_3D(box.hiVect()),
-			   BL_TO_FORTRAN_3D(stateMF[mfi]),
-			   ZFILL(dx),&dt);
-		}
-#ifdef _OPENMP
-#pragma omp critical (castro_estdt)
+#ifdef REACTIONS
+    do_dt[3] = do_react;
+
+    const MultiFab* R_new = &get_new_data(Reactions_Type);
+    const MultiFab* R_old = R_new;
+
+    if (state[State_Type].hasOldData() && state[Reactions_Type].hasOldData()) {
+	S_old = &get_old_data(State_Type);
+	R_old = &get_old_data(Reactions_Type);
+    }
 #endif
-	      {
-		estdt_hydro = std::min(estdt_hydro,dt);
-	      }
-	    }
-	  }
 
-#ifdef DIFFUSION
-	// Diffusion-limited timestep
-	// Note that the diffusion uses the same CFL safety factor
-	// as the main hydrodynamics timestep limiter.
-	if (diffuse_temp)
-	{
+    if (do_dt[0] || do_dt[1] || do_dt[2] || do_dt[3])
+    {
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
+	{
+	    Real dt[n_dt];
+	    int  loc[3*n_dt];
+
+	    for (int n = 0; n < n_dt; ++n)
+		dt[n] = dt_lim[n];
+	    for (int n = 0; n < 3*n_dt; ++n)
+		loc[n] = -1;
+
+	    for (MFIter mfi(stateMF,true); mfi.isValid(); ++mfi)
 	    {
-	      Real dt = max_dt / cfl;
-
-	      for (MFIter mfi(stateMF,true); mfi.isValid(); ++mfi)
-		{
-		  const Box& box = mfi.tilebox();
-		  ca_estdt_temp_diffusion(ARLIM_3D(box.loVect()), ARLIM_3D(box.hiVect()),
-			  	          BL_TO_FORTRAN_3D(stateMF[mfi]),
-				          ZFILL(dx),&dt);
-		}
-#ifdef _OPENMP
-#pragma omp critical (castro_estdt)
+		const Box& box = mfi.tilebox();
+
+		ca_estdt(ARLIM_3D(box.loVect()), ARLIM_3D(box.hiVect()),
+			 BL_TO_FORTRAN_3D((*S_old)[mfi]),
+			 BL_TO_FORTRAN_3D(stateMF[mfi]),
+#ifdef REACTIONS
+			 BL_TO_FORTRAN_3D((*R_old)[mfi]),
+			 BL_TO_FORTRAN_3D((*R_new)[mfi]),
 #endif
-	      {
-		estdt_hydro = std::min(estdt_hydro,dt);
-	      }
+			 ZFILL(dx),&dt_old,do_dt,dt,loc);
 	    }
-	}
-	if (diffuse_enth)
-	{
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp critical (castro_estdt)
 #endif
 	    {
-	      Real dt = max_dt / cfl;
-
-	      for (MFIter mfi(stateMF,true); mfi.isValid(); ++mfi)
-		{
-		  const Box& box = mfi.tilebox();
-		  ca_estdt_enth_diffusion(ARLIM_3D(box.loVect()), ARLIM_3D(box.hiVect()),
-				          BL_TO_FORTRAN_3D(stateMF[mfi]),
-				          ZFILL(dx),&dt);
+		for (int n = 0; n < n_dt; ++n) {
+		    if (dt[n] < dt_lim[n]) {
+			dt_lim[n] = dt[n];
+			for (int d = 0; d < 3; ++d)
+			    dt_loc[3*n+d] = loc[3*n+d];
+		    }
 		}
-#ifdef _OPENMP
-#pragma omp critical (castro_estdt)
-#endif
-	      {
-		estdt_hydro = std::min(estdt_hydro,dt);
-	      }
 	    }
 	}
-#endif  // diffusion
-
-#ifdef RADIATION
-      }
-#endif
-
-       ParallelDescriptor::ReduceRealMin(estdt_hydro);
-       estdt_hydro *= cfl;
-       if (verbose && ParallelDescriptor::IOProcessor())
-           std::cout << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
-
-       // Determine if this is more restrictive than the maximum timestep limiting
-
-       if (estdt_hydro < estdt) {
-	 limiter = "hydro";
-	 estdt = estdt_hydro;
-       }
     }
 
-#ifdef REACTIONS
-    MultiFab& S_new = get_new_data(State_Type);
-    MultiFab& R_new = get_new_data(Reactions_Type);
+    Real dt_local[n_dt];
+    for (int n = 0; n < n_dt; ++n)
+	dt_local[n] = dt_lim[n];
 
-    // Dummy value to start with
-    Real estdt_burn = max_dt;
+    ParallelDescriptor::ReduceRealMin(dt_lim, n_dt);
 
-    if (do_react) {
-
-        // Compute burning-limited timestep.
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-        {
-            Real dt = max_dt;
+    int winner = -1;
 
-	    for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
-	    {
-	        const Box& box = mfi.validbox();
-
-		if (state[State_Type].hasOldData() && state[Reactions_Type].hasOldData()) {
-
-		  MultiFab& S_old = get_old_data(State_Type);
-		  MultiFab& R_old = get_old_data(Reactions_Type);
-
-		  ca_estdt_burning(BL_TO_FORTRAN_3D(S_old[mfi]),
-                                   BL_TO_FORTRAN_3D(S_new[mfi]),
-				   BL_TO_FORTRAN_3D(R_old[mfi]),
-				   BL_TO_FORTRAN_3D(R_new[mfi]),
-				   ARLIM_3D(box.loVect()),ARLIM_3D(box.hiVect()),
-				   ZFILL(dx),&dt_old,&dt);
+    if (hydro_dt)
+    {
+	int n_hydro = 0;
+	for (int n = 1; n < 3; ++n)
+	    if (dt_lim[n] < dt_lim[n_hydro])
+		n_hydro = n;
 
-		} else {
+	Real estdt_hydro = dt_lim[n_hydro] * cfl;
 
-		  ca_estdt_burning(BL_TO_FORTRAN_3D(S_new[mfi]),
-                                   BL_TO_FORTRAN_3D(S_new[mfi]),
-				   BL_TO_FORTRAN_3D(R_new[mfi]),
-				   BL_TO_FORTRAN_3D(R_new[mfi]),
-				   ARLIM_3D(box.loVect()),ARLIM_3D(box.hiVect()),
-				   ZFILL(dx),&dt_old,&dt);
+	if (verbose && ParallelDescriptor::IOProcessor())
+	    std::cout << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
 
-		}
+	// Determine if this is more restrictive than the maximum timestep limiting
 
-	    }
-#ifdef _OPENMP
-#pragma omp critical (castro_estdt_burning)
-#endif
-	    {
-	        estdt_burn = std::min(estdt_burn,dt);
-	    }
+	if (estdt_hydro < estdt) {
+	    winner = n_hydro;
+	    estdt = estdt_hydro;
+	}
+    }
 
-        }
+#ifdef REACTIONS
+    if (do_react) {
 
-	ParallelDescriptor::ReduceRealMin(estdt_burn);
+	Real estdt_burn = dt_lim[3];
 
 	if (verbose && ParallelDescriptor::IOProcessor() && estdt_burn < max_dt)
 	  std::cout << "...estimated burning-limited timestep at level " << level << ": " << estdt_burn << std::endl;
@@ -1282,12 +1281,40 @@ Castro::estTimeStep (Real dt_old)
 	// Determine if this is more restrictive than the hydro limiting
 
 	if (estdt_burn < estdt) {
-	  limiter = "burning";
+	  winner = 3;
 	  estdt = estdt_burn;
 	}
     }
 #endif
 
+    if (winner >= 0) {
+
+	limiter = dt_names[winner];
+
+	// Find the zone that set the timestep: the lowest-numbered processor
+	// that has it tells the others.  This is only for reporting, so we
+	// only do the extra reductions when verbose.
+
+	if (verbose) {
+
+	    int owner = (dt_local[winner] == dt_lim[winner] && dt_loc[3*winner] != -1)
+		      ? ParallelDescriptor::MyProc() : ParallelDescriptor::NProcs();
+	    ParallelDescriptor::ReduceIntMin(owner);
+
+	    int where[3];
+	    for (int d = 0; d < 3; ++d)
+		where[d] = (ParallelDescriptor::MyProc() == owner) ? dt_loc[3*winner+d] : std::numeric_limits<int>::min();
+	    ParallelDescriptor::ReduceIntMax(where, 3);
+
+	    if (owner < ParallelDescriptor::NProcs() && ParallelDescriptor::IOProcessor()) {
+		std::cout << "...timestep at level " << level << " set by " << limiter << " in zone (";
+		for (int d = 0; d < BL_SPACEDIM; ++d)
+		    std::cout << where[d] << (d < BL_SPACEDIM-1 ? "," : ")");
+		std::cout << std::endl;
+	    }
+	}
+    }
+
 #ifdef RADIATION
     if (do_radiation) radiation->EstTimeStep(estdt, level);
 #endif
@@ -1528,7 +1555,24 @@ Castro::post_timestep (int iteration)
         if (sum_int_test || sum_per_test)
 	  sum_integrated_quantities();
 
+        if (use_retry) {
+
+            if ((num_retries > 0 || num_retry_forecasts > 0) && ParallelDescriptor::IOProcessor()) {
+                std::cout << "Retry log: " << num_retries << " level advance(s) retried and "
+                          << num_retry_forecasts << " subcycled on a forecast this step; "
+                          << retry_wasted_zones << " zone-updates wasted so far ("
+                          << 100.0 * retry_wasted_zones / std::max(retry_total_zones, 1.0)
+                          << "% of all)" << std::endl;
+            }
+
+            num_retries = 0;
+            num_retry_forecasts = 0;
+
+        }
+
 #ifdef SELF_GRAVITY
+        if (do_grav) gravity->report_skipped_solves();
+
         if (moving_center) write_center();
 #endif
     }
@@ -2761,6 +2805,8 @@ Castro::get_numpts ()
 void
 Castro::make_radial_data(int is_new)
 {
+    BL_PROFILE("Castro::make_radial_data()");
+
 #if (BL_SPACEDIM > 1)
 
  // We only call this for level = 0
@@ -2768,93 +2814,84 @@ Castro::make_radial_data(int is_new)
 
    int numpts_1d = get_numpts();
 
-   Array<Real> radial_vol(numpts_1d,0);
-
    const Real* dx = geom.CellSize();
    Real  dr = dx[0];
 
-   if (is_new == 1) {
-      MultiFab& S = get_new_data(State_Type);
-      int nc = S.nComp();
-      Array<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
-      {
-         Box bx(mfi.validbox());
-         ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-			     BL_TO_FORTRAN_3D(     S[mfi]),radial_state.dataPtr(),
-			     BL_TO_FORTRAN_3D(volume[mfi]),radial_vol.dataPtr(),
-			     ZFILL(geom.ProbLo()),&numpts_1d);
-      }
+   MultiFab& S = (is_new == 1) ? get_new_data(State_Type) : get_old_data(State_Type);
+   int nc = S.nComp();
 
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
+   // The volume goes after the state in the same array so that
+   // everything is reduced at once.  Each thread has its own bins.
 
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
-      }
+   const int nbins = numpts_1d*(nc+1);
 
-      Array<Real> radial_state_short(np_max*nc,0);
+#ifdef _OPENMP
+   const int nthreads = omp_get_max_threads();
+#else
+   const int nthreads = 1;
+#endif
 
-      for (int i = 0; i < np_max; i++) {
-         for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
-         }
-      }
+   Array<Real> radial_data(nbins,0);
+   Array<Real> priv_radial_data(nthreads*nbins,0);
 
-      Real new_time = state[State_Type].curTime();
-      set_new_outflow_data(radial_state_short.dataPtr(),&new_time,&np_max,&nc);
-   }
-   else
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
    {
-      MultiFab& S = get_old_data(State_Type);
-      int nc = S.nComp();
-      Array<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+      const int tid = omp_get_thread_num();
+#else
+      const int tid = 0;
+#endif
+      Real* priv_state = priv_radial_data.dataPtr() + tid*nbins;
+      Real* priv_vol   = priv_state + numpts_1d*nc;
+
+      for (MFIter mfi(S,true); mfi.isValid(); ++mfi)
       {
-         Box bx(mfi.validbox());
+         const Box& bx = mfi.tilebox();
          ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-			     BL_TO_FORTRAN_3D(     S[mfi]),radial_state.dataPtr(),
-			     BL_TO_FORTRAN_3D(volume[mfi]),radial_vol.dataPtr(),
-			     ZFILL(geom.ProbLo()),&numpts_1d);
+			     BL_TO_FORTRAN_3D(     S[mfi]),priv_state,
+			     BL_TO_FORTRAN_3D(volume[mfi]),priv_vol,
+			     ZFILL(geom.ProbLo()),&numpts_1d,&outflow_data_thermo_only);
       }
 
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp for
+#endif
+      for (int i = 0; i < nbins; i++)
+         for (int it = 0; it < nthreads; it++)
+            radial_data[i] += priv_radial_data[it*nbins+i];
+   }
 
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
-      }
+   ParallelDescriptor::ReduceRealSum(radial_data.dataPtr(),nbins);
 
-      Array<Real> radial_state_short(np_max*nc,0);
+   Real*       radial_state = radial_data.dataPtr();
+   const Real* radial_vol   = radial_data.dataPtr() + numpts_1d*nc;
 
-      for (int i = 0; i < np_max; i++) {
+   int first = 0;
+   int np_max = 0;
+   for (int i = 0; i < numpts_1d; i++) {
+      if (radial_vol[i] > 0.)
+      {
          for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
+           radial_state[nc*i+j] /= radial_vol[i];
          }
+      } else if (first == 0) {
+         np_max = i;
+         first  = 1;
       }
+   }
+
+   // The state for the first np_max points is at the start of
+   // radial_state, which is all the Fortran reads.
 
+   if (is_new == 1) {
+      Real new_time = state[State_Type].curTime();
+      set_new_outflow_data(radial_state,&new_time,&np_max,&nc);
+   } else {
       Real old_time = state[State_Type].prevTime();
-      set_old_outflow_data(radial_state_short.dataPtr(),&old_time,&np_max,&nc);
+      set_old_outflow_data(radial_state,&old_time,&np_max,&nc);
    }
 
 #endif
@@ -3010,13 +3047,80 @@ Castro::expand_state(MultiFab& S, Real time, int ng)
 {
     BL_ASSERT(S.nGrow() >= ng);
 
-    AmrLevel::FillPatch(*this,S,ng,time,State_Type,0,NUM_STATE);
+    fill_patch_cached(S,ng,time,State_Type,0,NUM_STATE);
 
     clean_state(S);
 
 }
 
 
+
+// The old-time data of this level (and the coarse data it is
+// interpolated from) does not change during the advance, so once it
+// has been filled with ghost zones, later requests for it can be
+// served with a local copy.  Only State_Type and Rad_Type are cached;
+// the cache is cleared at the start of each do_advance and when the
+// advance is done, so it never survives a change of the old data.
+
+void
+Castro::fill_patch_cached(MultiFab& S, int ng, Real time, int type, int scomp, int ncomp)
+{
+    BL_PROFILE("Castro::fill_patch_cached()");
+
+    BL_ASSERT(S.nGrow() >= ng);
+
+    const Real prev_time = state[type].prevTime();
+    const Real teps = (state[type].curTime() - prev_time) * 1.e-3;
+
+    bool cacheable = fill_patch_cache &&
+	(type == State_Type
+#ifdef RADIATION
+	 || type == Rad_Type
+#endif
+	 ) &&
+	std::abs(time - prev_time) <= teps &&
+	S.boxArray() == grids;
+
+    if (!cacheable) {
+	AmrLevel::FillPatch(*this,S,ng,time,type,scomp,ncomp);
+	return;
+    }
+
+    for (int i = 0; i < fill_patch_cache_entries.size(); ++i) {
+	const FillPatchCacheEntry& e = fill_patch_cache_entries[i];
+	if (e.type == type && std::abs(e.time - time) <= teps &&
+	    e.scomp <= scomp && e.scomp + e.ncomp >= scomp + ncomp &&
+	    e.mf->nGrow() >= ng) {
+	    MultiFab::Copy(S, *e.mf, scomp - e.scomp, 0, ncomp, ng);
+	    return;
+	}
+    }
+
+    MultiFab* mf = new MultiFab(grids, ncomp, ng, Fab_allocate);
+    AmrLevel::FillPatch(*this,*mf,ng,time,type,scomp,ncomp);
+    MultiFab::Copy(S, *mf, 0, 0, ncomp, ng);
+
+    FillPatchCacheEntry e;
+    e.type  = type;
+    e.scomp = scomp;
+    e.ncomp = ncomp;
+    e.time  = time;
+    e.mf    = mf;
+    fill_patch_cache_entries.push_back(e);
+}
+
+
+
+void
+Castro::clear_fill_patch_cache()
+{
+    for (int i = 0; i < fill_patch_cache_entries.size(); ++i) {
+	delete fill_patch_cache_entries[i].mf;
+    }
+    fill_patch_cache_entries.clear();
+}
+
+
 void
 Castro::check_for_nan(MultiFab& state, int check_ghost)
 {
@@ -3076,28 +3180,53 @@ Castro::cons_to_prim(MultiFab& u, MultiFab& q, MultiFab& qaux)
 Real
 Castro::clean_state(MultiFab& state) {
 
-    // Enforce a minimum density.
+    BL_PROFILE("Castro::clean_state()");
 
-    MultiFab temp_state(state.boxArray(), state.nComp(), state.nGrow(), Fab_allocate);
+    // The diagnostics of the resets need a copy of the state to measure
+    // the change against, and the radiation constant c_v temperature
+    // isn't in the fused kernel, so in those cases do the steps one by one.
 
-    MultiFab::Copy(temp_state, state, 0, 0, state.nComp(), state.nGrow());
+    bool fused = !print_update_diagnostics;
 
-    Real frac_change = enforce_min_density(temp_state, state);
+#ifdef RADIATION
+    if (Radiation::do_real_eos == 0)
+	fused = false;
+#endif
 
-    // Ensure all species are normalized.
+    if (!fused) {
 
-    normalize_species(state);
+	MultiFab temp_state(state.boxArray(), state.nComp(), state.nGrow(), Fab_allocate);
 
-    // Sync the linear and hybrid momenta.
+	MultiFab::Copy(temp_state, state, 0, 0, state.nComp(), state.nGrow());
 
-#ifdef HYBRID_MOMENTUM
-    hybrid_sync(state);
+	return clean_state(state, temp_state);
+
+    }
+
+    // Otherwise do all of the cleaning in one pass over the tiles, in place.
+
+    Real frac_change = 1.e0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(min:frac_change)
 #endif
+    for (MFIter mfi(state, true); mfi.isValid(); ++mfi) {
 
-    // Compute the temperature (note that this will also reset
-    // the internal energy for consistency with the total energy).
+	const Box& bx  = mfi.growntilebox();
+	const Box& vbx = mfi.tilebox();
 
-    computeTemp(state);
+	ca_clean_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+		       ARLIM_3D(vbx.loVect()), ARLIM_3D(vbx.hiVect()),
+		       BL_TO_FORTRAN_3D(state[mfi]),
+		       BL_TO_FORTRAN_3D(volume[mfi]),
+		       &frac_change, &verbose, &print_fortran_warnings);
+
+    }
+
+    // Flush Fortran output
+
+    if (verbose)
+      flush_output();
 
     return frac_change;
 
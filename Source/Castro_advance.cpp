@@ -43,6 +43,12 @@ Castro::advance (Real time,
 
     Real dt_new = dt;
 
+    // Any plotfile written at the end of the last coarse timestep is
+    // complete now, so its staged data can go to the I/O thread.
+
+    if (level == 0 && async_io == 1)
+        releaseAsyncIO();
+
     initialize_advance(time, dt, amr_iteration, amr_ncycle);
 
     // Do the advance.
@@ -92,14 +98,33 @@ Castro::advance (Real time,
     int sub_iteration = 0;
     int sub_ncycle = 0;
 
-    dt_new = do_advance(time, dt, amr_iteration, amr_ncycle, sub_iteration, sub_ncycle);
+    // If we expect this advance to violate the stability criteria,
+    // go straight to the subcycled advances rather than finding out
+    // after the fact.
+
+    Real dt_forecast = 1.e200;
+
+    if (use_retry && retry_forecast)
+        dt_forecast = forecast_timestep(dt);
+
+    if (dt_forecast < dt) {
+
+        dt_new = subcycle_advance(time, dt, amr_iteration, amr_ncycle, dt_forecast);
 
-    // Check to see if this advance violated certain stability criteria.
-    // If so, get a new timestep and do subcycled advances until we reach
-    // t = time + dt.
+    } else {
 
-    if (use_retry)
-        dt_new = std::min(dt_new, retry_advance(time, dt, amr_iteration, amr_ncycle));
+        dt_new = do_advance(time, dt, amr_iteration, amr_ncycle, sub_iteration, sub_ncycle);
+
+        // Check to see if this advance violated certain stability criteria.
+        // If so, get a new timestep and do subcycled advances until we reach
+        // t = time + dt.
+
+        if (use_retry) {
+            retry_total_zones += grids.numPts();
+            dt_new = std::min(dt_new, retry_advance(time, dt, amr_iteration, amr_ncycle));
+        }
+
+    }
 #endif
 
 #ifdef AUX_UPDATE
@@ -259,6 +284,11 @@ Castro::initialize_do_advance(Real time, Real dt, int amr_iteration, int amr_ncy
 
     frac_change = 1.e0;
 
+    // The old data of a retry subcycle is not that of the previous
+    // do_advance, so start with an empty ghost fill cache.
+
+    clear_fill_patch_cache();
+
     int finest_level = parent->finestLevel();
 
 #ifdef RADIATION
@@ -436,21 +466,23 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle
 
     clean_state(get_old_data(State_Type));
 
-    // Make a copy of the MultiFabs in the old and new state data in case we may do a retry.
-
-    if (use_retry) {
+    // In case we may do a retry, keep a copy of the data that the advance
+    // overwrites in place and that a retry would still need. The advance
+    // only reads the old-time state data, so that is not copied until we
+    // know we are subcycling (see subcycle_advance); the one exception
+    // is the dSdt of the source term predictor.
 
-      // Store the old and new time levels.
-
-      for (int k = 0; k < num_state_type; k++) {
+#ifndef SDC
+    if (use_retry && source_term_predictor == 1) {
 
-	prev_state.set(k, new StateData());
+        const MultiFab& dSdt_new = get_new_data(Source_Type);
 
-	StateData::Initialize(prev_state[k], state[k]);
+	prev_dSdt.define(dSdt_new.boxArray(), dSdt_new.nComp(), dSdt_new.nGrow(), Fab_allocate);
 
-      }
+	MultiFab::Copy(prev_dSdt, dSdt_new, 0, 0, dSdt_new.nComp(), dSdt_new.nGrow());
 
     }
+#endif
 
     MultiFab& S_new = get_new_data(State_Type);
 
@@ -563,25 +595,25 @@ Castro::finalize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle)
 
     sources_for_hydro.clear();
 
-    prev_state.clear();
+    prev_dSdt.clear();
+
+    clear_fill_patch_cache();
 
 }
 
 
 
 Real
-Castro::retry_advance(Real time, Real dt, int amr_iteration, int amr_ncycle)
+Castro::forecast_timestep(Real dt)
 {
+    BL_PROFILE("Castro::forecast_timestep()");
 
-    Real dt_new = 1.e200;
     Real dt_subcycle = 1.e200;
 
-    MultiFab& S_old = get_old_data(State_Type);
-    MultiFab& S_new = get_new_data(State_Type);
+    const MultiFab& S_old = get_old_data(State_Type);
 
 #ifdef REACTIONS
-    MultiFab& R_old = get_old_data(Reactions_Type);
-    MultiFab& R_new = get_new_data(Reactions_Type);
+    const MultiFab& R_old = get_old_data(Reactions_Type);
 #endif
 
     const Real* dx = geom.CellSize();
@@ -589,164 +621,259 @@ Castro::retry_advance(Real time, Real dt, int amr_iteration, int amr_ncycle)
 #ifdef _OPENMP
 #pragma omp parallel reduction(min:dt_subcycle)
 #endif
-    for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(S_old, true); mfi.isValid(); ++mfi) {
 
         const Box& bx = mfi.tilebox();
 
 	const int* lo = bx.loVect();
 	const int* hi = bx.hiVect();
 
-	ca_check_timestep(BL_TO_FORTRAN_3D(S_old[mfi]),
-			  BL_TO_FORTRAN_3D(S_new[mfi]),
+	ca_forecast_timestep(BL_TO_FORTRAN_3D(S_old[mfi]),
 #ifdef REACTIONS
-			  BL_TO_FORTRAN_3D(R_old[mfi]),
-			  BL_TO_FORTRAN_3D(R_new[mfi]),
+			     BL_TO_FORTRAN_3D(R_old[mfi]),
 #endif
-			  ARLIM_3D(lo), ARLIM_3D(hi), ZFILL(dx),
-			  &dt, &dt_subcycle);
+			     ARLIM_3D(lo), ARLIM_3D(hi), ZFILL(dx),
+			     &dt, &dt_subcycle);
 
     }
 
-    if (retry_neg_dens_factor > 0.0) {
+    ParallelDescriptor::ReduceRealMin(dt_subcycle);
 
-        // Negative density criterion
-	// Reset so that the desired maximum fractional change in density
-	// is not larger than retry_neg_dens_factor.
+    if (dt_subcycle < dt) {
 
-        ParallelDescriptor::ReduceRealMin(frac_change);
+	num_retry_forecasts++;
 
-	if (frac_change < 0.0)
-	  dt_subcycle = std::min(dt_subcycle, dt * -(retry_neg_dens_factor / frac_change));
+	if (verbose && ParallelDescriptor::IOProcessor()) {
+	  std::cout << std::endl;
+	  std::cout << "  Timestep " << dt << " at level " << level
+		    << " is forecast to violate the stability criteria." << std::endl;
+	}
 
     }
 
-    ParallelDescriptor::ReduceRealMin(dt_subcycle);
+    return dt_subcycle;
 
-    if (dt_subcycle < dt) {
+}
 
-        int sub_ncycle = ceil(dt / dt_subcycle);
 
-	if (verbose && ParallelDescriptor::IOProcessor()) {
-	  std::cout << std::endl;
-	  std::cout << "  Timestep " << dt << " rejected at level " << level << "." << std::endl;
-	  std::cout << "  Performing a retry, with " << sub_ncycle
-		    << " subcycled timesteps of maximum length dt = " << dt_subcycle << std::endl;
-	  std::cout << std::endl;
-	}
 
-	Real subcycle_time = time;
-	int sub_iteration = 1;
-	Real dt_advance = dt / sub_ncycle;
+Real
+Castro::subcycle_advance(Real time, Real dt, int amr_iteration, int amr_ncycle, Real dt_subcycle)
+{
+    // Advance from time to time + dt in subcycles no longer than dt_subcycle,
+    // starting from the old state data, and return dt_subcycle as a
+    // suggestion for the next timestep.
 
-	// Restore the original values of the state data.
+    int sub_ncycle = ceil(dt / dt_subcycle);
 
-	for (int k = 0; k < num_state_type; k++) {
+    if (verbose && ParallelDescriptor::IOProcessor()) {
+      std::cout << "  Performing a retry, with " << sub_ncycle
+		<< " subcycled timesteps of maximum length dt = " << dt_subcycle << std::endl;
+      std::cout << std::endl;
+    }
 
-	  if (prev_state[k].hasOldData())
-	      state[k].copyOld(prev_state[k]);
+    Real subcycle_time = time;
+    int sub_iteration = 1;
+    Real dt_advance = dt / sub_ncycle;
 
-	  if (prev_state[k].hasNewData())
-	      state[k].copyNew(prev_state[k]);
+    // Save the old-time data, which the subcycles will overwrite.
 
-	  // Anticipate the swapTimeLevels to come.
+    for (int k = 0; k < num_state_type; k++) {
 
-	  if (k == Source_Type)
-	      state[k].swapTimeLevels(0.0);
+      if (state[k].hasOldData()) {
+
+	  const MultiFab& S_old = get_old_data(k);
+
+	  prev_state.set(k, new MultiFab(S_old.boxArray(), S_old.nComp(), S_old.nGrow()));
+
+	  MultiFab::Copy(prev_state[k], S_old, 0, 0, S_old.nComp(), S_old.nGrow());
+
+      }
+
+    }
+
+    for (int k = 0; k < num_state_type; k++) {
+
+      // Anticipate the swapTimeLevels to come.
+
+      if (k == Source_Type)
+	  state[k].swapTimeLevels(0.0);
 #ifdef SDC
-	  else if (k == SDC_Source_Type)
-	      state[k].swapTimeLevels(0.0);
+      else if (k == SDC_Source_Type)
+	  state[k].swapTimeLevels(0.0);
 #ifdef REACTIONS
-	  else if (k == SDC_React_Type)
-	      state[k].swapTimeLevels(0.0);
+      else if (k == SDC_React_Type)
+	  state[k].swapTimeLevels(0.0);
 #endif
 #endif
 
-	  state[k].swapTimeLevels(0.0);
+      state[k].swapTimeLevels(0.0);
 
-	  state[k].setTimeLevel(time, 0.0, 0.0);
+      state[k].setTimeLevel(time, 0.0, 0.0);
 
-	}
+    }
 
-	if (track_grid_losses)
-	  for (int i = 0; i < n_lost; i++)
-	    material_lost_through_boundary_temp[i] = 0.0;
+    if (track_grid_losses)
+      for (int i = 0; i < n_lost; i++)
+	material_lost_through_boundary_temp[i] = 0.0;
 
-	// Subcycle until we've reached the target time.
+    // Subcycle until we've reached the target time.
 
-	while (subcycle_time < time + dt) {
+    while (subcycle_time < time + dt) {
 
-	    // Shorten the last timestep so that we don't overshoot
-	    // the ending time. We want to protect against taking
-	    // a very small last timestep due to precision issues,
-	    // so subtract a small number from that time.
+	// Shorten the last timestep so that we don't overshoot
+	// the ending time. We want to protect against taking
+	// a very small last timestep due to precision issues,
+	// so subtract a small number from that time.
 
-	    Real eps = 1.0e-10 * dt;
+	Real eps = 1.0e-10 * dt;
 
-	    if (subcycle_time + dt_advance > time + dt - eps)
-	        dt_advance = (time + dt) - subcycle_time;
+	if (subcycle_time + dt_advance > time + dt - eps)
+	    dt_advance = (time + dt) - subcycle_time;
 
-	    if (verbose && ParallelDescriptor::IOProcessor()) {
-	        std::cout << "  Beginning retry subcycle " << sub_iteration << " of " << sub_ncycle
-		          << ", starting at time " << subcycle_time
-		         << " with dt = " << dt_advance << std::endl << std::endl;
-	    }
+	if (verbose && ParallelDescriptor::IOProcessor()) {
+	    std::cout << "  Beginning retry subcycle " << sub_iteration << " of " << sub_ncycle
+		      << ", starting at time " << subcycle_time
+		     << " with dt = " << dt_advance << std::endl << std::endl;
+	}
 
-	    for (int k = 0; k < num_state_type; k++) {
+	for (int k = 0; k < num_state_type; k++) {
 
-	        if (k == Source_Type)
-		    state[k].swapTimeLevels(0.0);
+	    if (k == Source_Type)
+		state[k].swapTimeLevels(0.0);
 #ifdef SDC
-		else if (k == SDC_Source_Type)
-		    state[k].swapTimeLevels(0.0);
+	    else if (k == SDC_Source_Type)
+		state[k].swapTimeLevels(0.0);
 #ifdef REACTIONS
-		else if (k == SDC_React_Type)
-		    state[k].swapTimeLevels(0.0);
+	    else if (k == SDC_React_Type)
+		state[k].swapTimeLevels(0.0);
 #endif
 #endif
 
-		state[k].swapTimeLevels(dt_advance);
+	    state[k].swapTimeLevels(dt_advance);
 
-	    }
+	}
 
 #ifdef SELF_GRAVITY
-	    if (do_grav)
-	        gravity->swapTimeLevels(level);
+	if (do_grav)
+	    gravity->swapTimeLevels(level);
 #endif
 
-	    do_advance(subcycle_time,dt_advance,amr_iteration,amr_ncycle,sub_iteration,sub_ncycle);
-
-	    if (verbose && ParallelDescriptor::IOProcessor()) {
-	        std::cout << std::endl;
-	        std::cout << "  Retry subcycle " << sub_iteration << " of " << sub_ncycle << " completed" << std::endl;
-	        std::cout << std::endl;
-	    }
+	do_advance(subcycle_time,dt_advance,amr_iteration,amr_ncycle,sub_iteration,sub_ncycle);
 
-	  subcycle_time += dt_advance;
-	  sub_iteration += 1;
+	retry_total_zones += grids.numPts();
 
+	if (verbose && ParallelDescriptor::IOProcessor()) {
+	    std::cout << std::endl;
+	    std::cout << "  Retry subcycle " << sub_iteration << " of " << sub_ncycle << " completed" << std::endl;
+	    std::cout << std::endl;
 	}
 
-	// We want to return this subcycled timestep as a suggestion,
-	// if it is smaller than what the hydro estimates.
+      subcycle_time += dt_advance;
+      sub_iteration += 1;
 
-	dt_new = std::min(dt_new, dt_subcycle);
+    }
 
-	if (verbose && ParallelDescriptor::IOProcessor())
-            std::cout << "  Retry subcycling complete" << std::endl << std::endl;
+    if (verbose && ParallelDescriptor::IOProcessor())
+	std::cout << "  Retry subcycling complete" << std::endl << std::endl;
 
-	// Finally, copy the original data back to the old state
-	// data so that externally it appears like we took only
-	// a single timestep.
+    // Finally, copy the original data back to the old state
+    // data so that externally it appears like we took only
+    // a single timestep.
 
-	for (int k = 0; k < num_state_type; k++) {
+    for (int k = 0; k < num_state_type; k++) {
+
+       if (prev_state.defined(k))
+	  MultiFab::Copy(get_old_data(k), prev_state[k], 0, 0, prev_state[k].nComp(), prev_state[k].nGrow());
+
+       state[k].setTimeLevel(time + dt, dt, 0.0);
+
+    }
+
+    prev_state.clear();
+
+    // The old data has been put back, so the cached fills of the
+    // subcycles no longer apply.
+
+    clear_fill_patch_cache();
+
+    return dt_subcycle;
+
+}
+
+
+
+Real
+Castro::retry_advance(Real time, Real dt, int amr_iteration, int amr_ncycle)
+{
+
+    Real dt_new = 1.e200;
+    Real dt_subcycle = 1.e200;
+
+    MultiFab& S_old = get_old_data(State_Type);
+    MultiFab& S_new = get_new_data(State_Type);
+
+#ifdef REACTIONS
+    MultiFab& R_old = get_old_data(Reactions_Type);
+    MultiFab& R_new = get_new_data(Reactions_Type);
+#endif
+
+    const Real* dx = geom.CellSize();
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(min:dt_subcycle)
+#endif
+    for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi) {
 
-           if (prev_state[k].hasOldData())
-	      state[k].copyOld(prev_state[k]);
+        const Box& bx = mfi.tilebox();
 
-	   state[k].setTimeLevel(time + dt, dt, 0.0);
+	const int* lo = bx.loVect();
+	const int* hi = bx.hiVect();
 
+	ca_check_timestep(BL_TO_FORTRAN_3D(S_old[mfi]),
+			  BL_TO_FORTRAN_3D(S_new[mfi]),
+#ifdef REACTIONS
+			  BL_TO_FORTRAN_3D(R_old[mfi]),
+			  BL_TO_FORTRAN_3D(R_new[mfi]),
+#endif
+			  ARLIM_3D(lo), ARLIM_3D(hi), ZFILL(dx),
+			  &dt, &dt_subcycle);
+
+    }
+
+    if (retry_neg_dens_factor > 0.0) {
+
+        // Negative density criterion
+	// Reset so that the desired maximum fractional change in density
+	// is not larger than retry_neg_dens_factor.
+
+        ParallelDescriptor::ReduceRealMin(frac_change);
+
+	if (frac_change < 0.0)
+	  dt_subcycle = std::min(dt_subcycle, dt * -(retry_neg_dens_factor / frac_change));
+
+    }
+
+    ParallelDescriptor::ReduceRealMin(dt_subcycle);
+
+    if (dt_subcycle < dt) {
+
+	if (verbose && ParallelDescriptor::IOProcessor()) {
+	  std::cout << std::endl;
+	  std::cout << "  Timestep " << dt << " rejected at level " << level << "." << std::endl;
 	}
 
+	num_retries++;
+	retry_wasted_zones += grids.numPts();
+
+	// The advance left the old-time data alone, so all we need to put
+	// back is the dSdt it replaced.
+
+	if (source_term_predictor == 1)
+	    MultiFab::Copy(get_new_data(Source_Type), prev_dSdt, 0, 0, prev_dSdt.nComp(), prev_dSdt.nGrow());
+
+	dt_new = std::min(dt_new, subcycle_advance(time, dt, amr_iteration, amr_ncycle, dt_subcycle));
+
     }
 
     return dt_new;
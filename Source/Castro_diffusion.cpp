@@ -149,8 +149,8 @@ Castro::getTempDiffusionTerm (Real time, MultiFab& TempDiffTerm, int is_old)
    MultiFab Temperature(grids,1,1,Fab_allocate);
 
    {
-       FillPatchIterator fpi(*this, *S, 1, time, State_Type, 0, NUM_STATE);
-       MultiFab& state = fpi.get_mf();
+       MultiFab state(grids, NUM_STATE, 1, Fab_allocate);
+       fill_patch_cached(state, 1, time, State_Type, 0, NUM_STATE);
 
        MultiFab::Copy(Temperature, state, Temp, 0, 1, 1);
 
@@ -226,8 +226,8 @@ Castro::getEnthDiffusionTerm (Real time, MultiFab& DiffTerm, int is_old)
    // Define enthalpy at this level.
    MultiFab Enthalpy(grids,1,1,Fab_allocate);
    {
-       FillPatchIterator fpi(*this, *S, 1, time, State_Type, 0, NUM_STATE);
-       MultiFab& state = fpi.get_mf();
+       MultiFab state(grids, NUM_STATE, 1, Fab_allocate);
+       fill_patch_cached(state, 1, time, State_Type, 0, NUM_STATE);
 
        for (MFIter mfi(state); mfi.isValid(); ++mfi)
        {
@@ -311,8 +311,8 @@ Castro::getSpecDiffusionTerm (Real time, MultiFab& SpecDiffTerm, int is_old)
        }
    }
 
-   FillPatchIterator fpi(*this, *S, 1, time, State_Type, 0, NUM_STATE);
-   MultiFab& state = fpi.get_mf();
+   MultiFab state(grids, NUM_STATE, 1, Fab_allocate);
+   fill_patch_cached(state, 1, time, State_Type, 0, NUM_STATE);
 
    for (MFIter mfi(state); mfi.isValid(); ++mfi)
    {
@@ -414,8 +414,8 @@ Castro::getFirstViscousTerm (Real time, MultiFab& ViscousTerm)
    // Fill velocity at this level.
    MultiFab Vel(grids,1,1,Fab_allocate);
 
-   FillPatchIterator fpi(*this,S_old,1,time,State_Type,0,NUM_STATE);
-   MultiFab& state_old = fpi.get_mf();
+   MultiFab state_old(grids, NUM_STATE, 1, Fab_allocate);
+   fill_patch_cached(state_old, 1, time, State_Type, 0, NUM_STATE);
 
    // Remember this is just 1-d
    MultiFab::Copy  (Vel, state_old, Xmom   , 0, 1, 1);
@@ -480,8 +480,8 @@ Castro::getSecndViscousTerm (Real time, MultiFab& ViscousTerm)
    // Fill velocity at this level.
    MultiFab Vel(grids,1,1,Fab_allocate);
 
-   FillPatchIterator fpi(*this,S_old,1,time,State_Type,0,NUM_STATE);
-   MultiFab& state_old = fpi.get_mf();
+   MultiFab state_old(grids, NUM_STATE, 1, Fab_allocate);
+   fill_patch_cached(state_old, 1, time, State_Type, 0, NUM_STATE);
 
    // Remember this is just 1-d
    MultiFab::Copy  (Vel, state_old, Xmom   , 0, 1, 1);
@@ -543,8 +543,8 @@ Castro::getViscousTermForEnergy (Real time, MultiFab& ViscousTerm)
        }
    }
 
-   FillPatchIterator fpi(*this,S_old,2,time,State_Type,0,NUM_STATE);
-   MultiFab& state_old = fpi.get_mf();
+   MultiFab state_old(grids, NUM_STATE, 2, Fab_allocate);
+   fill_patch_cached(state_old, 2, time, State_Type, 0, NUM_STATE);
 
    const Geometry& fine_geom = parent->Geom(parent->finestLevel());
    const Real*       dx_fine = fine_geom.CellSize();
@@ -122,17 +122,33 @@ Castro::construct_new_gravity(int amr_iteration, int amr_ncycle, int sub_iterati
 
     }
 
-    // If we're doing Poisson gravity, do the new-time level solve here.
+    // If we're doing Poisson gravity, do the new-time level solve here,
+    // unless the density has hardly changed since the old-time solve.
 
-    if (gravity->get_gravity_type() == "PoissonGrav")
+    if (gravity->get_gravity_type() == "PoissonGrav" && gravity->skip_new_solve(level))
     {
 
-	// Use the "old" phi from the current time step as a guess for this solve.
+	// The old-time data is the composite solution (if we're doing
+	// composite solves), so this is what we would have had after
+	// adding back the (composite - level) contribution below.
 
 	MultiFab& phi_old = get_old_data(PhiGrav_Type);
 
 	MultiFab::Copy(phi_new, phi_old, 0, 0, 1, phi_new.nGrow());
 
+	for (int n = 0; n < BL_SPACEDIM; ++n)
+	    MultiFab::Copy(gravity->get_grad_phi_curr(level)[n], gravity->get_grad_phi_prev(level)[n],
+			   0, 0, 1, gravity->get_grad_phi_curr(level)[n].nGrow());
+
+    }
+    else if (gravity->get_gravity_type() == "PoissonGrav")
+    {
+
+	// Use the "old" phi from the current time step, extrapolated in
+	// time if possible, as a guess for this solve.
+
+	gravity->get_new_phi_guess(level, phi_new);
+
 	// Subtract off the (composite - level) contribution for the purposes
 	// of the level solve. We'll add it back later.
 
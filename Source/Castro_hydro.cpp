@@ -5,6 +5,52 @@
 #include "Radiation.H"
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+PArray<Castro::HydroScratch> Castro::hydro_scratch(PArrayManage);
+
+long
+Castro::HydroScratch::nBytes () const
+{
+    long bytes = q.nBytes() + qaux.nBytes() + src_q.nBytes();
+
+    for (int i = 0; i < BL_SPACEDIM; i++) {
+	bytes += flux[i].nBytes();
+#ifdef RADIATION
+	bytes += rad_flux[i].nBytes();
+#endif
+    }
+
+#if (BL_SPACEDIM <= 2)
+    bytes += pradial.nBytes();
+#endif
+
+    return bytes;
+}
+
+Castro::HydroScratch&
+Castro::get_hydro_scratch ()
+{
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+
+    // The array itself is sized outside of any parallel region;
+    // each thread then creates its own entry so that the memory
+    // is first touched by the thread that will use it.
+
+    BL_ASSERT(tid < hydro_scratch.size());
+
+    if (!hydro_scratch.defined(tid))
+	hydro_scratch.set(tid, new HydroScratch);
+
+    return hydro_scratch[tid];
+}
+
 void
 Castro::construct_hydro_source(Real time, Real dt)
 {
@@ -70,8 +116,8 @@ Castro::construct_hydro_source(Real time, Real dt)
       BoxLib::Abort("Castro::construct_hydro_source -- we don't implement a mode where we have radiation, but it is not coupled to hydro");
     }
 
-    FillPatchIterator fpi_rad(*this, Er_new, NUM_GROW, time, Rad_Type, 0, Radiation::nGroups);
-    MultiFab& Erborder = fpi_rad.get_mf();
+    MultiFab Erborder(grids, Radiation::nGroups, NUM_GROW, Fab_allocate);
+    fill_patch_cached(Erborder, NUM_GROW, time, Rad_Type, 0, Radiation::nGroups);
 
     MultiFab lamborder(grids, Radiation::nGroups, NUM_GROW);
     if (radiation->pure_hydro) {
@@ -94,6 +140,15 @@ Castro::construct_hydro_source(Real time, Real dt)
     Real yang_lost       = 0.;
     Real zang_lost       = 0.;
 
+#ifdef _OPENMP
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+
+    if (hydro_scratch.size() < nthreads)
+	hydro_scratch.resize(nthreads);
+
     BL_PROFILE_VAR("Castro::advance_hydro_ca_umdrv()", CA_UMDRV);
 
 #ifdef _OPENMP
@@ -106,14 +161,18 @@ Castro::construct_hydro_source(Real time, Real dt)
 #endif
     {
 
-      FArrayBox flux[BL_SPACEDIM];
+      HydroScratch& scratch = get_hydro_scratch();
+
+      FArrayBox (&flux)[BL_SPACEDIM] = scratch.flux;
 #if (BL_SPACEDIM <= 2)
-      FArrayBox pradial(Box::TheUnitBox(),1);
+      FArrayBox& pradial = scratch.pradial;
 #endif
 #ifdef RADIATION
-      FArrayBox rad_flux[BL_SPACEDIM];
+      FArrayBox (&rad_flux)[BL_SPACEDIM] = scratch.rad_flux;
 #endif
-      FArrayBox q, qaux, src_q;
+      FArrayBox& q = scratch.q;
+      FArrayBox& qaux = scratch.qaux;
+      FArrayBox& src_q = scratch.src_q;
 
       int priv_nstep_fsp = -1;
 
@@ -152,26 +211,38 @@ Castro::construct_hydro_source(Real time, Real dt)
 	  qaux.resize(qbx, NQAUX);
 	  src_q.resize(qbx, QVAR);
 
-	  // convert the conservative state to the primitive variable state.
-	  // this fills both q and qaux.
-
-	  ctoprim(ARLIM_3D(qbx.loVect()), ARLIM_3D(qbx.hiVect()),
-		  statein.dataPtr(), ARLIM_3D(statein.loVect()), ARLIM_3D(statein.hiVect()),
+	  // Convert the conservative state to the primitive variable state
+	  // (this fills both q and qaux), and then convert the source terms
+	  // expressed as sources to the conserved state to those expressed
+	  // as sources for the primitive state. Both conversions are purely
+	  // zone-local, so we can optionally do them together in slabs along
+	  // the last coordinate direction; then srctoprim reads q and qaux
+	  // while they are still in cache rather than from main memory.
+
+	  const int sdir = BL_SPACEDIM - 1;
+	  const int slab_size = (hydro_prim_slab_size > 0) ? hydro_prim_slab_size : qbx.length(sdir);
+
+	  for (int slo = qbx.smallEnd(sdir); slo <= qbx.bigEnd(sdir); slo += slab_size)
+	  {
+	      Box sbx(qbx);
+	      sbx.setSmall(sdir, slo);
+	      sbx.setBig(sdir, std::min(slo + slab_size - 1, qbx.bigEnd(sdir)));
+
+	      ctoprim(ARLIM_3D(sbx.loVect()), ARLIM_3D(sbx.hiVect()),
+		      statein.dataPtr(), ARLIM_3D(statein.loVect()), ARLIM_3D(statein.hiVect()),
 #ifdef RADIATION
-		  Er.dataPtr(), ARLIM_3D(Er.loVect()), ARLIM_3D(Er.hiVect()),
-		  lam.dataPtr(), ARLIM_3D(lam.loVect()), ARLIM_3D(lam.hiVect()),
+		      Er.dataPtr(), ARLIM_3D(Er.loVect()), ARLIM_3D(Er.hiVect()),
+		      lam.dataPtr(), ARLIM_3D(lam.loVect()), ARLIM_3D(lam.hiVect()),
 #endif
-		  q.dataPtr(), ARLIM_3D(q.loVect()), ARLIM_3D(q.hiVect()),
-		  qaux.dataPtr(), ARLIM_3D(qaux.loVect()), ARLIM_3D(qaux.hiVect()));
-
-	  // convert the source terms expressed as sources to the conserved state to those
-	  // expressed as sources for the primitive state.
+		      q.dataPtr(), ARLIM_3D(q.loVect()), ARLIM_3D(q.hiVect()),
+		      qaux.dataPtr(), ARLIM_3D(qaux.loVect()), ARLIM_3D(qaux.hiVect()));
 
-	  srctoprim(ARLIM_3D(qbx.loVect()), ARLIM_3D(qbx.hiVect()),
-		    q.dataPtr(), ARLIM_3D(q.loVect()), ARLIM_3D(q.hiVect()),
-		    qaux.dataPtr(), ARLIM_3D(qaux.loVect()), ARLIM_3D(qaux.hiVect()),
-		    source_in.dataPtr(), ARLIM_3D(source_in.loVect()), ARLIM_3D(source_in.hiVect()),
-		    src_q.dataPtr(), ARLIM_3D(src_q.loVect()), ARLIM_3D(src_q.hiVect()));
+	      srctoprim(ARLIM_3D(sbx.loVect()), ARLIM_3D(sbx.hiVect()),
+			q.dataPtr(), ARLIM_3D(q.loVect()), ARLIM_3D(q.hiVect()),
+			qaux.dataPtr(), ARLIM_3D(qaux.loVect()), ARLIM_3D(qaux.hiVect()),
+			source_in.dataPtr(), ARLIM_3D(source_in.loVect()), ARLIM_3D(source_in.hiVect()),
+			src_q.dataPtr(), ARLIM_3D(src_q.loVect()), ARLIM_3D(src_q.hiVect()));
+	  }
 
 #ifndef RADIATION
 
@@ -199,6 +270,8 @@ Castro::construct_hydro_source(Real time, Real dt)
 	  }
 #endif
 
+	  scratch.high_water_bytes = std::max(scratch.high_water_bytes, scratch.nBytes());
+
 	  ca_umdrv
 	    (&is_finest_level, &time,
 	     lo, hi, domain_lo, domain_hi,
@@ -282,6 +355,22 @@ Castro::construct_hydro_source(Real time, Real dt)
 
     BL_PROFILE_VAR_STOP(CA_UMDRV);
 
+    if (verbose > 1)
+    {
+	// Report the size of the hydro scratch space, summed over the
+	// threads, on the rank that holds the most.
+
+	Real scratch_mb = 0.0;
+	for (int i = 0; i < hydro_scratch.size(); i++)
+	    if (hydro_scratch.defined(i))
+		scratch_mb += hydro_scratch[i].high_water_bytes / (1024.0 * 1024.0);
+
+	ParallelDescriptor::ReduceRealMax(scratch_mb, ParallelDescriptor::IOProcessorNumber());
+
+	if (ParallelDescriptor::IOProcessor())
+	    std::cout << "... hydro scratch space high-water mark: " << scratch_mb << " MB per rank" << std::endl;
+    }
+
 #ifdef RADIATION
     if (radiation->verbose>=1) {
 #ifdef BL_LAZY
@@ -6,13 +6,22 @@
 
 #include <iomanip>
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <ctime>
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include <Utility.H>
 #include "Castro.H"
 #include "Castro_F.H"
 #include "Castro_io.H"
+#include "Castro_codec.H"
 #include <ParmParse.H>
 
 #ifdef RADIATION
@@ -993,7 +1002,7 @@ Castro::writePlotFile (const std::string& dir,
     // but a derived variable is allowed to have multiple components.
     int       cnt   = 0;
     const int nGrow = 0;
-    MultiFab  plotMF(grids,n_data_items,nGrow);
+    MultiFab* plotMF = new MultiFab(grids,n_data_items,nGrow);
     MultiFab* this_dat = 0;
     //
     // Cull data from state variables -- use no ghost cells.
@@ -1003,7 +1012,7 @@ Castro::writePlotFile (const std::string& dir,
 	int typ  = plot_var_map[i].first;
 	int comp = plot_var_map[i].second;
 	this_dat = &state[typ].newData();
-	MultiFab::Copy(plotMF,*this_dat,comp,cnt,1,nGrow);
+	MultiFab::Copy(*plotMF,*this_dat,comp,cnt,1,nGrow);
 	cnt++;
     }
     //
@@ -1015,7 +1024,7 @@ Castro::writePlotFile (const std::string& dir,
 	     it != derive_names.end(); ++it)
 	{
 	    MultiFab* derive_dat = derive(*it,cur_time,nGrow);
-	    MultiFab::Copy(plotMF,*derive_dat,0,cnt,1,nGrow);
+	    MultiFab::Copy(*plotMF,*derive_dat,0,cnt,1,nGrow);
 	    delete derive_dat;
 	    cnt++;
 	}
@@ -1023,17 +1032,31 @@ Castro::writePlotFile (const std::string& dir,
 
 #ifdef RADIATION
     if (Radiation::nplotvar > 0) {
-	MultiFab::Copy(plotMF,radiation->plotvar[level],0,cnt,Radiation::nplotvar,0);
+	MultiFab::Copy(*plotMF,radiation->plotvar[level],0,cnt,Radiation::nplotvar,0);
 	cnt += Radiation::nplotvar;
     }
 #endif
 
     //
-    // Use the Full pathname when naming the MultiFab.
+    // The names of the plot variables, in the order of plotMF.
     //
-    std::string TheFullPath = FullPath;
-    TheFullPath += BaseName;
-    VisMF::Write(plotMF,TheFullPath,how,true);
+    Array<std::string> plot_names;
+    for (i = 0; i < plot_var_map.size(); i++)
+	plot_names.push_back(desc_lst[plot_var_map[i].first].name(plot_var_map[i].second));
+    for (std::list<std::string>::iterator it = derive_names.begin();
+	 it != derive_names.end(); ++it)
+	plot_names.push_back(derive_lst.get(*it)->variableName(0));
+#ifdef RADIATION
+    for (i = 0; i < Radiation::nplotvar; i++)
+	plot_names.push_back(Radiation::plotvar_names[i]);
+#endif
+
+    //
+    // The name of the MultiFab relative to the plotfile directory.
+    //
+    std::string TheRelativePath = Level;
+    TheRelativePath += BaseName;
+    writePlotData(plotMF,dir,TheRelativePath,how,plot_names);
 }
 
 void
@@ -1167,7 +1190,7 @@ Castro::writeSmallPlotFile (const std::string& dir,
     // but a derived variable is allowed to have multiple components.
     int       cnt   = 0;
     const int nGrow = 0;
-    MultiFab  plotMF(grids,n_data_items,nGrow);
+    MultiFab* plotMF = new MultiFab(grids,n_data_items,nGrow);
     MultiFab* this_dat = 0;
     //
     // Cull data from state variables -- use no ghost cells.
@@ -1177,15 +1200,391 @@ Castro::writeSmallPlotFile (const std::string& dir,
 	int typ  = plot_var_map[i].first;
 	int comp = plot_var_map[i].second;
 	this_dat = &state[typ].newData();
-	MultiFab::Copy(plotMF,*this_dat,comp,cnt,1,nGrow);
+	MultiFab::Copy(*plotMF,*this_dat,comp,cnt,1,nGrow);
 	cnt++;
     }
 
     //
-    // Use the Full pathname when naming the MultiFab.
+    // The names of the plot variables, in the order of plotMF.
+    //
+    Array<std::string> plot_names;
+    for (i = 0; i < plot_var_map.size(); i++)
+	plot_names.push_back(desc_lst[plot_var_map[i].first].name(plot_var_map[i].second));
+
+    //
+    // The name of the MultiFab relative to the plotfile directory.
+    //
+    std::string TheRelativePath = Level;
+    TheRelativePath += BaseName;
+    writePlotData(plotMF,dir,TheRelativePath,how,plot_names);
+
+}
+
+//
+// Asynchronous plotfile writing.
+//
+// With async_io = 1 the plot MultiFab of each level is kept in memory
+// and its FABs are written from a background thread while the run
+// continues.  Everything that needs communication (the min/max of
+// each FAB and the VisMF header) is done synchronously when the data
+// is staged, so the I/O thread only writes FABs of this MPI task,
+// one file per FAB.
+//
+// Amr writes a plotfile into a temporary directory and renames it
+// once all levels are done, so the staged data is only handed to the
+// I/O thread at the start of the next coarse timestep (or at the end
+// of the run).
+//
+// With plot_compression = 1 the FABs are written the same way, one
+// file per FAB, but encoded with the codecs in Castro_codec.H (in the
+// I/O thread if async_io = 1).
+//
+
+namespace
+{
+    struct AsyncPlotData
+    {
+        MultiFab*                     mf;
+        std::string                   dir;
+        std::string                   mf_name;
+        std::vector<int>              index;
+        std::vector<const FArrayBox*> fab;
+        std::vector<int>              codec;    // empty: plain FABs
+        Real                          rel_tol;
+        long                          bytes;
+        bool                          done;
+    };
+
+    std::mutex                  async_mutex;
+    std::condition_variable     async_cv;
+    std::thread                 async_thread;
+    bool                        async_stop = false;
+
+    // Staged but not yet handed to the I/O thread -- main thread only.
+    std::vector<AsyncPlotData*> async_staged;
+
+    // Handed to the I/O thread and not yet freed -- main thread only.
+    std::vector<AsyncPlotData*> async_released;
+
+    // Work for the I/O thread -- guarded by async_mutex, as is the
+    // done flag of the released data.
+    std::deque<AsyncPlotData*>  async_queue;
+
+    // Bytes held by the staged and released data -- main thread only.
+    long                        async_bytes = 0;
+}
+
+static std::string
+plot_fab_file_name (const std::string& mf_name, int idx, bool compressed)
+{
+    char buf[64];
+    sprintf(buf, compressed ? "_Z_%05d" : "_D_%05d", idx);
+    return mf_name + buf;
+}
+
+static void
+write_plot_fabs (const AsyncPlotData& pd)
+{
+    const std::string full_name = pd.dir + "/" + pd.mf_name;
+
+    const bool compressed = !pd.codec.empty();
+
+    for (int k = 0; k < pd.fab.size(); ++k)
+    {
+        const std::string file_name = plot_fab_file_name(full_name, pd.index[k], compressed);
+
+        std::ofstream ofs(file_name.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+
+        if (!ofs.good())
+            BoxLib::FileOpenFailed(file_name);
+
+        if (compressed)
+            CastroCodec::writeFab(ofs, *pd.fab[k], pd.codec, pd.rel_tol);
+        else
+            pd.fab[k]->writeOn(ofs);
+
+        ofs.close();
+    }
+}
+
+static void
+async_io_worker ()
+{
+    for (;;)
+    {
+        AsyncPlotData* pd;
+
+        {
+            std::unique_lock<std::mutex> lock(async_mutex);
+            async_cv.wait(lock, [] { return async_stop || !async_queue.empty(); });
+
+            if (async_queue.empty())
+                return;
+
+            pd = async_queue.front();
+            async_queue.pop_front();
+        }
+
+        write_plot_fabs(*pd);
+
+        {
+            std::lock_guard<std::mutex> lock(async_mutex);
+            pd->done = true;
+        }
+
+        async_cv.notify_all();
+    }
+}
+
+//
+// Free the data the I/O thread is done with, optionally waiting for
+// all of the released data first.  The MultiFabs are freed here, on
+// the main thread, since the FAB arena is not thread safe.
+//
+
+static void
+reap_async_io (bool wait)
+{
+    std::unique_lock<std::mutex> lock(async_mutex);
+
+    if (wait)
+        async_cv.wait(lock, [] {
+            for (int i = 0; i < async_released.size(); ++i)
+                if (!async_released[i]->done) return false;
+            return true;
+        });
+
+    std::vector<AsyncPlotData*> busy;
+
+    for (int i = 0; i < async_released.size(); ++i)
+    {
+        AsyncPlotData* pd = async_released[i];
+
+        if (pd->done) {
+            async_bytes -= pd->bytes;
+            delete pd->mf;
+            delete pd;
+        } else {
+            busy.push_back(pd);
+        }
+    }
+
+    async_released.swap(busy);
+}
+
+void
+Castro::writePlotData (MultiFab*          plotMF,
+                       const std::string& dir,
+                       const std::string& mf_name,
+                       VisMF::How         how,
+                       const Array<std::string>& var_names)
+{
+    std::string path = dir;
+    while (path.size() > 1 && path[path.size()-1] == '/')
+        path.erase(path.size()-1);
+
+    bool stage = false;
+
+    long bytes = 0;
+
+    if (async_io == 1)
+    {
+        // Earlier plotfiles have to be on disk before we stage another.
+
+        reap_async_io(true);
+
+        for (MFIter mfi(*plotMF); mfi.isValid(); ++mfi)
+            bytes += (*plotMF)[mfi].nBytes();
+
+        const long budget = static_cast<long>(async_io_max_mb * 1024.0 * 1024.0);
+
+        int fits = (async_bytes + bytes <= budget);
+
+        ParallelDescriptor::ReduceIntMin(fits);
+
+        stage = (fits == 1);
+
+        if (!stage && verbose && ParallelDescriptor::IOProcessor())
+            std::cout << "... async_io_max_mb exceeded, writing " << mf_name << " synchronously" << std::endl;
+    }
+
+    const bool compressed = (plot_compression == 1);
+
+    if (!stage && !compressed)
+    {
+        VisMF::Write(*plotMF, path + "/" + mf_name, how, true);
+        delete plotMF;
+        return;
+    }
+
+    const int nfabs = plotMF->boxArray().size();
+    const int ncomp = plotMF->nComp();
+
+    Array<Real> fab_min(nfabs * ncomp,  std::numeric_limits<Real>::max());
+    Array<Real> fab_max(nfabs * ncomp, -std::numeric_limits<Real>::max());
+
+    AsyncPlotData* pd = new AsyncPlotData;
+
+    pd->mf      = plotMF;
+    pd->dir     = path;
+    pd->mf_name = mf_name;
+    pd->rel_tol = plot_lossy_rel_tol;
+    pd->bytes   = bytes;
+    pd->done    = false;
+
+    if (compressed)
+    {
+        BL_ASSERT(var_names.size() == ncomp);
+
+        pd->codec.resize(ncomp, CastroCodec::Lossless);
+
+        for (int n = 0; n < ncomp; ++n)
+            for (int m = 0; m < plot_lossy_vars.size(); ++m)
+                if (var_names[n] == plot_lossy_vars[m])
+                    pd->codec[n] = CastroCodec::Lossy;
+    }
+
+    for (MFIter mfi(*plotMF); mfi.isValid(); ++mfi)
+    {
+        const int idx = mfi.index();
+        const FArrayBox& fab = (*plotMF)[mfi];
+
+        for (int n = 0; n < ncomp; ++n) {
+            fab_min[idx * ncomp + n] = fab.min(mfi.validbox(), n);
+            fab_max[idx * ncomp + n] = fab.max(mfi.validbox(), n);
+        }
+
+        pd->index.push_back(idx);
+        pd->fab.push_back(&fab);
+    }
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceRealMin(fab_min.dataPtr(), fab_min.size(), IOProc);
+    ParallelDescriptor::ReduceRealMax(fab_max.dataPtr(), fab_max.size(), IOProc);
+
+    //
+    // Write the VisMF header, pointing each FAB to its own file.  For a
+    // compressed plotfile only Util/ConvertCheckpoint/Uncompress can
+    // read the FABs it points to.
     //
-    std::string TheFullPath = FullPath;
-    TheFullPath += BaseName;
-    VisMF::Write(plotMF,TheFullPath,how,true);
+    if (ParallelDescriptor::IOProcessor())
+    {
+        const std::string header_name = path + "/" + mf_name + "_H";
+
+        std::string base_name = mf_name;
+        if (base_name.rfind('/') != std::string::npos)
+            base_name = base_name.substr(base_name.rfind('/') + 1);
+
+        std::ofstream hdr(header_name.c_str(), std::ios::out | std::ios::trunc);
+
+        if (!hdr.good())
+            BoxLib::FileOpenFailed(header_name);
+
+        hdr.setf(std::ios::scientific, std::ios::floatfield);
+        hdr.precision(17);
+
+        hdr << 1 << '\n';                         // VisMF::Header::Version_v1
+        hdr << int(VisMF::OneFilePerCPU) << '\n';
+        hdr << ncomp << '\n';
+        hdr << plotMF->nGrow() << '\n';
+
+        plotMF->boxArray().writeOn(hdr);
+        hdr << '\n';
+
+        hdr << nfabs << '\n';
+        for (int i = 0; i < nfabs; ++i)
+            hdr << "FabOnDisk: " << plot_fab_file_name(base_name, i, compressed) << ' ' << 0 << '\n';
+        hdr << '\n';
+
+        hdr << nfabs << ',' << ncomp << '\n';
+        for (int i = 0; i < nfabs; ++i) {
+            for (int n = 0; n < ncomp; ++n)
+                hdr << fab_min[i * ncomp + n] << ',';
+            hdr << '\n';
+        }
+        hdr << '\n';
+
+        hdr << nfabs << ',' << ncomp << '\n';
+        for (int i = 0; i < nfabs; ++i) {
+            for (int n = 0; n < ncomp; ++n)
+                hdr << fab_max[i * ncomp + n] << ',';
+            hdr << '\n';
+        }
+        hdr << '\n';
 
+        hdr.close();
+    }
+
+    if (stage)
+    {
+        async_staged.push_back(pd);
+        async_bytes += bytes;
+    }
+    else
+    {
+        write_plot_fabs(*pd);
+        delete pd->mf;
+        delete pd;
+    }
+}
+
+void
+Castro::releaseAsyncIO ()
+{
+    if (!async_staged.empty())
+    {
+        if (!async_thread.joinable())
+            async_thread = std::thread(async_io_worker);
+
+        const std::string tmp_suffix(".temp");
+
+        {
+            std::lock_guard<std::mutex> lock(async_mutex);
+
+            for (int i = 0; i < async_staged.size(); ++i)
+            {
+                AsyncPlotData* pd = async_staged[i];
+
+                // Follow the plotfile if Amr has moved it out of its
+                // temporary directory.
+
+                if (pd->dir.size() > tmp_suffix.size() &&
+                    pd->dir.compare(pd->dir.size() - tmp_suffix.size(), tmp_suffix.size(), tmp_suffix) == 0 &&
+                    !BoxLib::FileExists(pd->dir))
+                    pd->dir.erase(pd->dir.size() - tmp_suffix.size());
+
+                async_queue.push_back(pd);
+                async_released.push_back(pd);
+            }
+        }
+
+        async_staged.clear();
+
+        async_cv.notify_all();
+    }
+
+    reap_async_io(false);
+}
+
+void
+Castro::finishAsyncIO ()
+{
+    releaseAsyncIO();
+
+    reap_async_io(true);
+
+    if (async_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(async_mutex);
+            async_stop = true;
+        }
+
+        async_cv.notify_all();
+
+        async_thread.join();
+
+        async_stop = false;
+    }
 }
@@ -9,6 +9,80 @@ using std::string;
 
 #ifndef SDC
 
+// Break bx into pieces of at most chunk_size zones, each a single
+// run of zones along x, and append them to the list of burning work.
+
+static void
+add_react_chunks(int idx, const Box& bx, int chunk_size,
+		 Array<int>& chunk_fab, Array<Box>& chunk_box)
+{
+    Box flat(bx);
+    flat.setBig(0, bx.smallEnd(0));
+
+    for (IntVect iv = flat.smallEnd(); iv <= flat.bigEnd(); flat.next(iv))
+    {
+	for (int ilo = bx.smallEnd(0); ilo <= bx.bigEnd(0); ilo += chunk_size)
+	{
+	    Box chunk(iv, iv);
+	    chunk.setSmall(0, ilo);
+	    chunk.setBig(0, std::min(ilo + chunk_size - 1, bx.bigEnd(0)));
+
+	    chunk_fab.push_back(idx);
+	    chunk_box.push_back(chunk);
+	}
+    }
+}
+
+// Find the zones in bx that will actually burn and append the runs
+// of them along x (split to at most chunk_size zones) to the list of
+// burning work.
+
+static void
+add_react_candidate_chunks(int idx, const Box& bx, int chunk_size,
+			   const FArrayBox& s, FArrayBox& w, const IArrayBox& mask,
+			   Array<int>& chunk_fab, Array<Box>& chunk_box)
+{
+    IArrayBox cand(bx, 1);
+
+    ca_burn_candidates(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+		       BL_TO_FORTRAN_3D(s),
+		       BL_TO_FORTRAN_3D(w),
+		       BL_TO_FORTRAN_3D(mask),
+		       BL_TO_FORTRAN_3D(cand));
+
+    Box flat(bx);
+    flat.setBig(0, bx.smallEnd(0));
+
+    for (IntVect iv = flat.smallEnd(); iv <= flat.bigEnd(); flat.next(iv))
+    {
+	IntVect cell(iv);
+	int run_start = -1;
+
+	for (int i = bx.smallEnd(0); i <= bx.bigEnd(0) + 1; ++i)
+	{
+	    cell[0] = i;
+	    const bool burn = (i <= bx.bigEnd(0)) && cand(cell) == 1;
+
+	    if (burn && run_start < 0)
+		run_start = i;
+
+	    if ((!burn && run_start >= 0) || (burn && i - run_start + 1 == chunk_size))
+	    {
+		const int run_end = burn ? i : i - 1;
+
+		Box chunk(iv, iv);
+		chunk.setSmall(0, run_start);
+		chunk.setBig(0, run_end);
+
+		chunk_fab.push_back(idx);
+		chunk_box.push_back(chunk);
+
+		run_start = -1;
+	    }
+	}
+    }
+}
+
 void
 Castro::strang_react_first_half(Real time, Real dt)
 {
@@ -55,7 +129,6 @@ Castro::strang_react_first_half(Real time, Real dt)
     // deleting things at the end.
 
     PArray<MultiFab> temp_data(PArrayManage);
-    PArray<iMultiFab> temp_idata(PArrayManage);
 
     if (use_custom_knapsack_weights) {
 
@@ -65,31 +138,28 @@ Castro::strang_react_first_half(Real time, Real dt)
 	// done a swap on the new data for the old data, so this is
 	// really the new-time burn from the last timestep.
 
-	const DistributionMapping& dm = DistributionMapping::makeKnapSack(get_old_data(Knapsack_Weight_Type));
+	get_burn_dmap(get_old_data(Knapsack_Weight_Type));
+
+	const int half = 0;
+
+	define_burn_data(state, reactions, *weights, interior_mask, half);
 
-	state_temp = temp_data.push_back(new MultiFab(state.boxArray(), state.nComp(), state.nGrow(), dm));
-	reactions_temp = temp_data.push_back(new MultiFab(reactions.boxArray(), reactions.nComp(), reactions.nGrow(), dm));
-	weights_temp = temp_data.push_back(new MultiFab(weights->boxArray(), weights->nComp(), weights->nGrow(), dm));
-	mask_temp = temp_idata.push_back(new iMultiFab(interior_mask.boxArray(), interior_mask.nComp(), interior_mask.nGrow(), dm));
+	state_temp = &burn_state[half];
+	reactions_temp = &burn_reactions[half];
+	weights_temp = &burn_weights[half];
+	mask_temp = &burn_mask[half];
 
 	// Copy data from the state. Note that this is a parallel copy
 	// from FabArray, and the parallel copy assumes that the data
 	// on the ghost zones in state is valid and consistent with
 	// the data on the interior zones, since either the ghost or
 	// valid zones may end up filling a given destination zone.
+	// Since the burn distribution map persists, the communication
+	// pattern for this copy (and the copies back) is cached by
+	// BoxLib and reused from step to step.
 
 	state_temp->copy(state, 0, 0, state.nComp(), state.nGrow(), state.nGrow());
 
-	// Create the mask. We cannot use the interior_mask from above, generated by
-	// Castro::build_interior_boundary_mask, because we need it to exist on the
-	// current DistributionMap and a parallel copy won't work for the mask.
-
-	int ghost_covered_by_valid = 0;
-	int other_cells = 1; // uncovered ghost, valid, and outside domain cells are set to 1
-
-	mask_temp->BuildMask(geom.Domain(), geom.periodicity(),
-		             ghost_covered_by_valid, other_cells, other_cells, other_cells);
-
     }
     else {
 
@@ -166,7 +236,6 @@ Castro::strang_react_second_half(Real time, Real dt)
     MultiFab* weights_temp;
 
     PArray<MultiFab> temp_data(PArrayManage);
-    PArray<iMultiFab> temp_idata(PArrayManage);
 
     if (use_custom_knapsack_weights) {
 
@@ -174,20 +243,18 @@ Castro::strang_react_second_half(Real time, Real dt)
 
 	// Here we use the old-time weights filled in during the first-half Strang-split burn.
 
-	const DistributionMapping& dm = DistributionMapping::makeKnapSack(get_old_data(Knapsack_Weight_Type));
+	get_burn_dmap(get_old_data(Knapsack_Weight_Type));
 
-	state_temp = temp_data.push_back(new MultiFab(state.boxArray(), state.nComp(), state.nGrow(), dm));
-	reactions_temp = temp_data.push_back(new MultiFab(reactions.boxArray(), reactions.nComp(), reactions.nGrow(), dm));
-	weights_temp = temp_data.push_back(new MultiFab(weights->boxArray(), weights->nComp(), weights->nGrow(), dm));
-	mask_temp = temp_idata.push_back(new iMultiFab(interior_mask.boxArray(), interior_mask.nComp(), interior_mask.nGrow(), dm));
+	const int half = 1;
 
-	state_temp->copy(state, 0, 0, state.nComp(), state.nGrow(), state.nGrow());
+	define_burn_data(state, reactions, *weights, interior_mask, half);
 
-	int ghost_covered_by_valid = 0;
-	int other_cells = 1;
+	state_temp = &burn_state[half];
+	reactions_temp = &burn_reactions[half];
+	weights_temp = &burn_weights[half];
+	mask_temp = &burn_mask[half];
 
-	mask_temp->BuildMask(geom.Domain(), geom.periodicity(),
-		             ghost_covered_by_valid, other_cells, other_cells, other_cells);
+	state_temp->copy(state, 0, 0, state.nComp(), state.nGrow(), state.nGrow());
 
     }
     else {
@@ -224,6 +291,134 @@ Castro::strang_react_second_half(Real time, Real dt)
 
 
 
+const DistributionMapping&
+Castro::get_burn_dmap(const MultiFab& weights)
+{
+
+    // Decide whether the persistent burn distribution map is still
+    // good enough. We measure the burn cost of each box from the
+    // weights and see how unevenly it is spread across the ranks;
+    // only if that exceeds burn_rebalance_threshold do we pay for a
+    // new knapsack distribution (and new communication patterns).
+
+    bool rebuild = true;
+    Real imbalance = 0.0;
+
+    if (burn_dmap.ProcessorMap().size() > 0 && burn_rebalance_threshold > 0.0) {
+
+	imbalance = burn_imbalance(weights, burn_dmap);
+
+	rebuild = imbalance > burn_rebalance_threshold;
+
+    }
+
+    if (rebuild) {
+
+	burn_dmap = DistributionMapping::makeKnapSack(weights);
+
+	burn_data_stale[0] = true;
+	burn_data_stale[1] = true;
+
+    }
+
+    if (verbose && ParallelDescriptor::IOProcessor()) {
+	if (rebuild)
+	    std::cout << "... rebuilding the burn distribution map on level " << level;
+	else
+	    std::cout << "... reusing the burn distribution map on level " << level;
+	if (imbalance > 0.0)
+	    std::cout << " (measured burn imbalance " << imbalance << ")";
+	std::cout << std::endl;
+    }
+
+    return burn_dmap;
+
+}
+
+
+
+Real
+Castro::burn_imbalance(const MultiFab& weights, const DistributionMapping& dm)
+{
+
+    // Total up the burn cost of each box. Each box is owned by one
+    // rank, so a sum reduction gives every rank the full list.
+
+    const int nboxes = weights.size();
+
+    Array<Real> cost(nboxes, 0.0);
+
+    for (MFIter mfi(weights); mfi.isValid(); ++mfi)
+	cost[mfi.index()] = weights[mfi].sum(mfi.validbox(), 0);
+
+    ParallelDescriptor::ReduceRealSum(cost.dataPtr(), nboxes);
+
+    // Now see how that cost is spread over the ranks under dm.
+
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    Array<Real> load(nprocs, 0.0);
+
+    Real total_cost = 0.0;
+
+    for (int i = 0; i < nboxes; ++i) {
+	load[dm[i]] += cost[i];
+	total_cost += cost[i];
+    }
+
+    if (total_cost <= 0.0) return 1.0;
+
+    Real max_load = 0.0;
+
+    for (int n = 0; n < nprocs; ++n)
+	max_load = std::max(max_load, load[n]);
+
+    return max_load * nprocs / total_cost;
+
+}
+
+
+
+void
+Castro::define_burn_data(const MultiFab& state, const MultiFab& reactions,
+			 const MultiFab& weights, const iMultiFab& mask, int half)
+{
+
+    // (Re)allocate the burn temporaries for this Strang half if the
+    // distribution map has changed. The two halves keep separate
+    // temporaries since they burn on different numbers of ghost zones.
+
+    if (!burn_data_stale[half] && burn_state[half].ok() &&
+	burn_state[half].nGrow() == state.nGrow() &&
+	burn_mask[half].nGrow() == mask.nGrow())
+	return;
+
+    burn_state[half].clear();
+    burn_reactions[half].clear();
+    burn_weights[half].clear();
+    burn_mask[half].clear();
+
+    burn_state[half].define(state.boxArray(), state.nComp(), state.nGrow(), burn_dmap, Fab_allocate);
+    burn_reactions[half].define(reactions.boxArray(), reactions.nComp(), reactions.nGrow(), burn_dmap, Fab_allocate);
+    burn_weights[half].define(weights.boxArray(), weights.nComp(), weights.nGrow(), burn_dmap, Fab_allocate);
+    burn_mask[half].define(mask.boxArray(), mask.nComp(), mask.nGrow(), burn_dmap, Fab_allocate);
+
+    // Create the mask. We cannot use the interior_mask generated by
+    // Castro::build_interior_boundary_mask, because we need it to exist on the
+    // burn DistributionMap and a parallel copy won't work for the mask.
+
+    int ghost_covered_by_valid = 0;
+    int other_cells = 1; // uncovered ghost, valid, and outside domain cells are set to 1
+
+    burn_mask[half].BuildMask(geom.Domain(), geom.periodicity(),
+			      ghost_covered_by_valid, other_cells, other_cells, other_cells);
+
+    burn_data_stale[half] = false;
+
+}
+
+
+
 void
 Castro::react_state(MultiFab& s, MultiFab& r, const iMultiFab& mask, MultiFab& w, Real time, Real dt_react, int ngrow)
 {
@@ -236,21 +431,115 @@ Castro::react_state(MultiFab& s, MultiFab& r, const iMultiFab& mask, MultiFab& w
 
     w.setVal(1.0);
 
+    if (react_schedule == 1 || react_compact_zones == 1) {
+
+	// The cost of a zone's burn can vary by orders of magnitude,
+	// so a static split of tiles over threads leaves most threads
+	// idle while a few work on the zones near a flame. Instead,
+	// gather small chunks of work from every box on this rank
+	// and let the threads pull them from a shared list.
+
+	const int chunk_size = std::max(1, react_chunk_size);
+
+	Array<int> chunk_fab;
+	Array<Box> chunk_box;
+
+	if (react_compact_zones == 1) {
+
+	    // Only keep the zones that will actually burn. Finding them
+	    // requires an EOS call per zone, so do it in parallel over
+	    // the boxes and then stitch the per-box lists together.
+
+	    Array<int> box_idx;
+
+	    for (MFIter mfi(s); mfi.isValid(); ++mfi)
+		box_idx.push_back(mfi.index());
+
+	    const int nboxes = box_idx.size();
+
+	    Array< Array<int> > box_chunk_fab(nboxes);
+	    Array< Array<Box> > box_chunk_box(nboxes);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	    for (int b = 0; b < nboxes; ++b)
+	    {
+		const int idx = box_idx[b];
+		const Box& bx = BoxLib::grow(s.boxArray()[idx], ngrow);
+
+		add_react_candidate_chunks(idx, bx, chunk_size, s[idx], w[idx], mask[idx],
+					   box_chunk_fab[b], box_chunk_box[b]);
+	    }
+
+	    for (int b = 0; b < nboxes; ++b)
+		for (int n = 0; n < box_chunk_box[b].size(); ++n) {
+		    chunk_fab.push_back(box_chunk_fab[b][n]);
+		    chunk_box.push_back(box_chunk_box[b][n]);
+		}
+
+	}
+	else {
+
+	    for (MFIter mfi(s); mfi.isValid(); ++mfi)
+		add_react_chunks(mfi.index(), mfi.growntilebox(ngrow), chunk_size,
+				 chunk_fab, chunk_box);
+
+	}
+
+	const int nchunks = chunk_box.size();
+
+	if (verbose > 1) {
+
+	    long nzones = 0;
+	    for (int n = 0; n < nchunks; ++n)
+		nzones += chunk_box[n].numPts();
+
+	    ParallelDescriptor::ReduceLongSum(nzones, ParallelDescriptor::IOProcessorNumber());
+
+	    if (ParallelDescriptor::IOProcessor())
+		std::cout << "... burning " << nzones << " zones on level " << level << std::endl;
+
+	}
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int n = 0; n < nchunks; ++n)
+	{
+
+	    const int idx = chunk_fab[n];
+	    const Box& bx = chunk_box[n];
+
+	    ca_react_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+			   BL_TO_FORTRAN_3D(s[idx]),
+			   BL_TO_FORTRAN_3D(r[idx]),
+			   BL_TO_FORTRAN_3D(w[idx]),
+			   BL_TO_FORTRAN_3D(mask[idx]),
+			   time, dt_react);
+
+	}
+
+    }
+    else {
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-    for (MFIter mfi(s, true); mfi.isValid(); ++mfi)
-    {
+	for (MFIter mfi(s, true); mfi.isValid(); ++mfi)
+	{
 
-	const Box& bx = mfi.growntilebox(ngrow);
+	    const Box& bx = mfi.growntilebox(ngrow);
 
-	// Note that box is *not* necessarily just the valid region!
-	ca_react_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
-		       BL_TO_FORTRAN_3D(s[mfi]),
-		       BL_TO_FORTRAN_3D(r[mfi]),
-		       BL_TO_FORTRAN_3D(w[mfi]),
-		       BL_TO_FORTRAN_3D(mask[mfi]),
-		       time, dt_react);
+	    // Note that box is *not* necessarily just the valid region!
+	    ca_react_state(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+			   BL_TO_FORTRAN_3D(s[mfi]),
+			   BL_TO_FORTRAN_3D(r[mfi]),
+			   BL_TO_FORTRAN_3D(w[mfi]),
+			   BL_TO_FORTRAN_3D(mask[mfi]),
+			   time, dt_react);
+
+	}
 
     }
 
@@ -60,14 +60,21 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _Density)
     level_solver_resnorm(MAX_LEV),
     volume(MAX_LEV),
     area(MAX_LEV),
+    phi_prev(MAX_LEV,PArrayManage),
+    phi_prev_time(MAX_LEV),
+#if (BL_SPACEDIM < 3)
+    metric_coeffs(MAX_LEV),
+#endif
     phys_bc(_phys_bc)
 {
      Density = _Density;
      read_params();
      finest_level_allocated = -1;
+     num_new_solves = 0;
+     num_new_solves_skipped = 0;
      if (gravity_type == "PoissonGrav") make_mg_bc();
 #if (BL_SPACEDIM > 1)
-     if (gravity_type == "PoissonGrav") init_multipole_grav();
+     if (gravity_type == "PoissonGrav" || gravity_type == "MultipoleGrav") init_multipole_grav();
 #endif
      max_rhs = 0.0;
 }
@@ -88,12 +95,25 @@ Gravity::read_params ()
         if ( (gravity_type != "ConstantGrav") &&
 	     (gravity_type != "PoissonGrav") &&
 	     (gravity_type != "MonopoleGrav") &&
+	     (gravity_type != "MultipoleGrav") &&
              (gravity_type != "PrescribedGrav") )
              {
                 std::cout << "Sorry -- dont know this gravity type"  << std::endl;
-        	BoxLib::Abort("Options are ConstantGrav, PoissonGrav, MonopoleGrav, or PrescribedGrav");
+        	BoxLib::Abort("Options are ConstantGrav, PoissonGrav, MonopoleGrav, MultipoleGrav, or PrescribedGrav");
              }
 
+#if (BL_SPACEDIM < 3)
+        if (gravity_type == "MultipoleGrav")
+        {
+	  BoxLib::Abort(" gravity_type = MultipoleGrav is only implemented in 3-d");
+        }
+#else
+        if (gravity_type == "MultipoleGrav" && !Geometry::IsCartesian())
+        {
+	  BoxLib::Abort(" gravity_type = MultipoleGrav requires Cartesian coordinates");
+        }
+#endif
+
         if (  gravity_type == "ConstantGrav")
         {
 	  if ( Geometry::IsSPHERICAL() )
@@ -273,6 +293,15 @@ Gravity::install_level (int                   level,
 
     level_solver_resnorm[level] = 0.0;
 
+    // Anything we saved for the old grids is no longer valid.
+
+    if (phi_prev.defined(level))
+	phi_prev.clear(level);
+
+#if (BL_SPACEDIM < 3)
+    metric_coeffs[level].clear();
+#endif
+
     if (gravity_type == "PoissonGrav") {
 
        // For code cleanliness purposes, we'll define grad_phi to have components
@@ -471,6 +500,92 @@ Gravity::solve_for_phi (int               level,
     }
 }
 
+void
+Gravity::get_new_phi_guess (int level, MultiFab& phi_new)
+{
+    BL_PROFILE("Gravity::get_new_phi_guess()");
+
+    const MultiFab& phi_old = LevelData[level].get_old_data(PhiGrav_Type);
+
+    const Real t_old = LevelData[level].get_state_data(PhiGrav_Type).prevTime();
+    const Real t_new = LevelData[level].get_state_data(PhiGrav_Type).curTime();
+
+    const int ng = phi_new.nGrow();
+
+    MultiFab::Copy(phi_new, phi_old, 0, 0, 1, ng);
+
+    if (!extrapolate_phi_guess) return;
+
+    // If we still have the old-time phi of the previous step on these
+    // grids, extrapolate linearly in time to t_new; the solve then
+    // starts much closer to the answer.
+
+    if (phi_prev.defined(level) && phi_prev[level].boxArray() == phi_old.boxArray() &&
+	phi_prev_time[level] < t_old)
+    {
+	const Real fac = (t_new - t_old) / (t_old - phi_prev_time[level]);
+
+	MultiFab::Saxpy(phi_new,  fac, phi_old,         0, 0, 1, ng);
+	MultiFab::Saxpy(phi_new, -fac, phi_prev[level], 0, 0, 1, ng);
+    }
+
+    if (!phi_prev.defined(level))
+	phi_prev.set(level, new MultiFab(phi_old.boxArray(), 1, ng));
+
+    MultiFab::Copy(phi_prev[level], phi_old, 0, 0, 1, ng);
+    phi_prev_time[level] = t_old;
+}
+
+bool
+Gravity::skip_new_solve (int level)
+{
+    if (skip_new_solve_tol <= 0.0) return false;
+
+    BL_PROFILE("Gravity::skip_new_solve()");
+
+    // The old-time solve is always done, so the old-time phi is up to
+    // date; if the density has changed by less than skip_new_solve_tol
+    // (relative to its maximum) over the step it is good enough for the
+    // new time as well.
+
+    const MultiFab& S_old = LevelData[level].get_old_data(State_Type);
+    const MultiFab& S_new = LevelData[level].get_new_data(State_Type);
+
+    MultiFab drho(grids[level], 1, 0);
+    MultiFab::Copy(drho, S_new, Density, 0, 1, 0);
+    MultiFab::Saxpy(drho, -1.0, S_old, Density, 0, 1, 0);
+
+    const Real drho_max = drho.norm0();
+    const Real rho_max  = S_old.norm0(Density);
+
+    const bool skip = drho_max <= skip_new_solve_tol * rho_max;
+
+    num_new_solves++;
+    if (skip) num_new_solves_skipped++;
+
+    if (skip && verbose && ParallelDescriptor::IOProcessor()) {
+	std::cout << " ... skipping new-time level solve at level " << level
+		  << ", relative density change = "
+		  << (rho_max > 0.0 ? drho_max / rho_max : 0.0) << std::endl;
+    }
+
+    return skip;
+}
+
+void
+Gravity::report_skipped_solves ()
+{
+    if (skip_new_solve_tol <= 0.0) return;
+
+    if (ParallelDescriptor::IOProcessor()) {
+	std::cout << "Gravity: skipped " << num_new_solves_skipped << " of "
+		  << num_new_solves << " new-time level solves this step" << std::endl;
+    }
+
+    num_new_solves = 0;
+    num_new_solves_skipped = 0;
+}
+
 void
 Gravity::solve_for_delta_phi (int                        crse_level,
                               int                        fine_level,
@@ -514,14 +629,12 @@ Gravity::solve_for_delta_phi (int                        crse_level,
     {
 	for (int ilev = 0; ilev < nlevs; ++ilev) {
 	    int amr_lev = ilev + crse_level;
-	    coeffs[ilev].resize(BL_SPACEDIM, PArrayManage);
-	    for (int i = 0; i < BL_SPACEDIM ; i++) {
-		coeffs[ilev].set(i, new MultiFab(grids[amr_lev], 1, 0, Fab_allocate,
-						 IntVect::TheDimensionVector(i)));
-		coeffs[ilev][i].setVal(1.0);
-	    }
+	    PArray<MultiFab>& mc = get_metric_coeffs(amr_lev);
+	    coeffs[ilev].resize(BL_SPACEDIM);
+	    for (int i = 0; i < BL_SPACEDIM ; i++)
+		coeffs[ilev].set(i, &mc[i]);
 
-	    applyMetricTerms(amr_lev, rhs[ilev], coeffs[ilev]);
+	    applyMetricTermsRhs(amr_lev, rhs[ilev]);
 	}
 
 	fmg.set_gravity_coeffs(coeffs);
@@ -998,6 +1111,14 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
        make_radial_gravity(level,prev_time,radial_grav_old[level]);
        interpolate_monopole_grav(level,radial_grav_old[level],grav);
 
+#if (BL_SPACEDIM == 3)
+    } else if (gravity_type == "MultipoleGrav") {
+
+       MultiFab& phi = LevelData[level].get_old_data(PhiGrav_Type);
+       const Real prev_time = LevelData[level].get_state_data(State_Type).prevTime();
+       make_multipole_gravity(level,prev_time,grav,phi);
+#endif
+
     } else if (gravity_type == "PrescribedGrav") {
 
 	MultiFab& phi = LevelData[level].get_old_data(PhiGrav_Type);
@@ -1076,6 +1197,14 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
 	make_radial_gravity(level,cur_time,radial_grav_new[level]);
 	interpolate_monopole_grav(level,radial_grav_new[level],grav);
 
+#if (BL_SPACEDIM == 3)
+    } else if (gravity_type == "MultipoleGrav") {
+
+	MultiFab& phi = LevelData[level].get_new_data(PhiGrav_Type);
+	const Real cur_time = LevelData[level].get_state_data(State_Type).curTime();
+	make_multipole_gravity(level,cur_time,grav,phi);
+#endif
+
     } else if (gravity_type == "PrescribedGrav") {
 
     MultiFab& phi = LevelData[level].get_new_data(PhiGrav_Type);
@@ -1618,9 +1747,9 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const PArray<MultiFa
     qUC.setVal(0.0);
     qUS.setVal(0.0);
 
-    // This section needs to be generalized for computing
-    // full multipole gravity, not just BCs. At present this
-    // does nothing.
+    // We only need the moments for the boundary values here;
+    // the full multipole gravity (gravity_type = MultipoleGrav)
+    // is constructed in make_multipole_gravity.
 
 #if (BL_SPACEDIM == 3)
     int boundary_only = 1;
@@ -1699,7 +1828,7 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const PArray<MultiFa
 					     qL0.dataPtr(),qLC.dataPtr(),qLS.dataPtr(),
 					     qU0.dataPtr(),qUC.dataPtr(),qUS.dataPtr(),
 #endif
-					     &npts,&boundary_only);
+					     &npts,&dx[0],&boundary_only);
 	}
 
 #ifdef _OPENMP
@@ -1798,7 +1927,7 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const PArray<MultiFa
 			     &lnum,
 			     qL0.dataPtr(),qLC.dataPtr(),qLS.dataPtr(),
 			     qU0.dataPtr(),qUC.dataPtr(),qUS.dataPtr(),
-			     &npts,&boundary_only);
+			     &npts,&dx[0],&boundary_only);
     }
 
     if (verbose)
@@ -1822,61 +1951,29 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const PArray<MultiFa
 
 #if (BL_SPACEDIM == 3)
 void
-Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiFab>& Rhs, MultiFab& phi)
+Gravity::compute_direct_sum_bcs(int crse_level, int fine_level, const PArray<MultiFab>& Rhs, Real theta,
+				FArrayBox& bcXYLo, FArrayBox& bcXYHi,
+				FArrayBox& bcXZLo, FArrayBox& bcXZHi,
+				FArrayBox& bcYZLo, FArrayBox& bcYZHi)
 {
-    BL_ASSERT(crse_level==0);
-
-    const Real strt = ParallelDescriptor::second();
+    // Add the potential of the density on levels crse_level..fine_level to the
+    // boundary values, either exactly (theta = 0) or with a tree code.
 
     const Geometry& crse_geom = parent->Geom(crse_level);
 
-    // Storage arrays for the BCs.
-
     const int* domlo = crse_geom.Domain().loVect();
     const int* domhi = crse_geom.Domain().hiVect();
 
-    const int loVectXY[3] = {domlo[0]-1, domlo[1]-1, 0         };
-    const int hiVectXY[3] = {domhi[0]+1, domhi[1]+1, 0         };
-
-    const int loVectXZ[3] = {domlo[0]-1, 0         , domlo[2]-1};
-    const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
-
-    const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
-    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[1]+1};
-
     const int bclo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
     const int bchi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
 
     const Real* bcdx = crse_geom.CellSize();
 
-    IntVect smallEndXY( loVectXY );
-    IntVect bigEndXY  ( hiVectXY );
-    IntVect smallEndXZ( loVectXZ );
-    IntVect bigEndXZ  ( hiVectXZ );
-    IntVect smallEndYZ( loVectYZ );
-    IntVect bigEndYZ  ( hiVectYZ );
-
-    Box boxXY(smallEndXY, bigEndXY);
-    Box boxXZ(smallEndXZ, bigEndXZ);
-    Box boxYZ(smallEndYZ, bigEndYZ);
+    const long nPtsXY = bcXYLo.box().numPts();
+    const long nPtsXZ = bcXZLo.box().numPts();
+    const long nPtsYZ = bcYZLo.box().numPts();
 
-    const long nPtsXY = boxXY.numPts();
-    const long nPtsXZ = boxXZ.numPts();
-    const long nPtsYZ = boxYZ.numPts();
-
-    FArrayBox bcXYLo(boxXY);
-    FArrayBox bcXYHi(boxXY);
-    FArrayBox bcXZLo(boxXZ);
-    FArrayBox bcXZHi(boxXZ);
-    FArrayBox bcYZLo(boxYZ);
-    FArrayBox bcYZHi(boxYZ);
-
-    bcXYLo.setVal(0.0);
-    bcXYHi.setVal(0.0);
-    bcXZLo.setVal(0.0);
-    bcXZHi.setVal(0.0);
-    bcYZLo.setVal(0.0);
-    bcYZHi.setVal(0.0);
+    const bool use_tiling = (theta <= 0.0);
 
     // Loop through the grids and compute the individual contributions
     // to the BCs. The BC constructor is coded to only add to the
@@ -1917,12 +2014,12 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiF
 	PArray<FArrayBox> priv_bcYZLo(nthreads, PArrayManage);
 	PArray<FArrayBox> priv_bcYZHi(nthreads, PArrayManage);
 	for (int i=0; i<nthreads; i++) {
-	    priv_bcXYLo.set(i, new FArrayBox(boxXY));
-	    priv_bcXYHi.set(i, new FArrayBox(boxXY));
-	    priv_bcXZLo.set(i, new FArrayBox(boxXZ));
-	    priv_bcXZHi.set(i, new FArrayBox(boxXZ));
-	    priv_bcYZLo.set(i, new FArrayBox(boxYZ));
-	    priv_bcYZHi.set(i, new FArrayBox(boxYZ));
+	    priv_bcXYLo.set(i, new FArrayBox(bcXYLo.box()));
+	    priv_bcXYHi.set(i, new FArrayBox(bcXYLo.box()));
+	    priv_bcXZLo.set(i, new FArrayBox(bcXZLo.box()));
+	    priv_bcXZHi.set(i, new FArrayBox(bcXZLo.box()));
+	    priv_bcYZLo.set(i, new FArrayBox(bcYZLo.box()));
+	    priv_bcYZHi.set(i, new FArrayBox(bcYZLo.box()));
 	}
 #pragma omp parallel
 #endif
@@ -1936,31 +2033,47 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiF
 	    priv_bcYZLo[tid].setVal(0.0);
 	    priv_bcYZHi[tid].setVal(0.0);
 #endif
-	    for (MFIter mfi(source,true); mfi.isValid(); ++mfi)
+	    // The tree is built over a whole grid, so we only tile the exact sum.
+
+	    for (MFIter mfi(source,use_tiling); mfi.isValid(); ++mfi)
 	    {
 		const Box bx = mfi.tilebox();
 
 		const FArrayBox& r = source[mfi];
 		const FArrayBox& v = volume[lev][mfi];
 
-		ca_compute_direct_sum_bc(bx.loVect(), bx.hiVect(), dx,
-					 &symmetry_type, lo_bc, hi_bc,
-					 r.dataPtr(), ARLIM_3D(r.loVect()), ARLIM_3D(r.hiVect()),
-					 v.dataPtr(), ARLIM_3D(v.loVect()), ARLIM_3D(v.hiVect()),
-					 crse_geom.ProbLo(),crse_geom.ProbHi(),
 #ifdef _OPENMP
-					 priv_bcXYLo[tid].dataPtr(),
-					 priv_bcXYHi[tid].dataPtr(),
-					 priv_bcXZLo[tid].dataPtr(),
-					 priv_bcXZHi[tid].dataPtr(),
-					 priv_bcYZLo[tid].dataPtr(),
-					 priv_bcYZHi[tid].dataPtr(),
+		Real* pXYLo = priv_bcXYLo[tid].dataPtr();
+		Real* pXYHi = priv_bcXYHi[tid].dataPtr();
+		Real* pXZLo = priv_bcXZLo[tid].dataPtr();
+		Real* pXZHi = priv_bcXZHi[tid].dataPtr();
+		Real* pYZLo = priv_bcYZLo[tid].dataPtr();
+		Real* pYZHi = priv_bcYZHi[tid].dataPtr();
 #else
-					 bcXYLo.dataPtr(), bcXYHi.dataPtr(),
-					 bcXZLo.dataPtr(), bcXZHi.dataPtr(),
-					 bcYZLo.dataPtr(), bcYZHi.dataPtr(),
-#endif
-	                                 bclo, bchi, bcdx);
+		Real* pXYLo = bcXYLo.dataPtr();
+		Real* pXYHi = bcXYHi.dataPtr();
+		Real* pXZLo = bcXZLo.dataPtr();
+		Real* pXZHi = bcXZHi.dataPtr();
+		Real* pYZLo = bcYZLo.dataPtr();
+		Real* pYZHi = bcYZHi.dataPtr();
+#endif
+
+		if (theta > 0.0)
+		    ca_compute_direct_sum_bc_tree(bx.loVect(), bx.hiVect(), dx,
+						  &symmetry_type, lo_bc, hi_bc,
+						  r.dataPtr(), ARLIM_3D(r.loVect()), ARLIM_3D(r.hiVect()),
+						  v.dataPtr(), ARLIM_3D(v.loVect()), ARLIM_3D(v.hiVect()),
+						  crse_geom.ProbLo(),crse_geom.ProbHi(),
+						  pXYLo, pXYHi, pXZLo, pXZHi, pYZLo, pYZHi,
+						  bclo, bchi, bcdx, &theta);
+		else
+		    ca_compute_direct_sum_bc(bx.loVect(), bx.hiVect(), dx,
+					     &symmetry_type, lo_bc, hi_bc,
+					     r.dataPtr(), ARLIM_3D(r.loVect()), ARLIM_3D(r.hiVect()),
+					     v.dataPtr(), ARLIM_3D(v.loVect()), ARLIM_3D(v.hiVect()),
+					     crse_geom.ProbLo(),crse_geom.ProbHi(),
+					     pXYLo, pXYHi, pXZLo, pXZHi, pYZLo, pYZHi,
+					     bclo, bchi, bcdx);
 	    }
 
 #ifdef _OPENMP
@@ -2014,6 +2127,100 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiF
     ParallelDescriptor::ReduceRealSum(bcXZHi.dataPtr(), nPtsXZ);
     ParallelDescriptor::ReduceRealSum(bcYZLo.dataPtr(), nPtsYZ);
     ParallelDescriptor::ReduceRealSum(bcYZHi.dataPtr(), nPtsYZ);
+}
+
+void
+Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiFab>& Rhs, MultiFab& phi)
+{
+    BL_ASSERT(crse_level==0);
+
+    const Real strt = ParallelDescriptor::second();
+
+    const Geometry& crse_geom = parent->Geom(crse_level);
+
+    // Storage arrays for the BCs.
+
+    const int* domlo = crse_geom.Domain().loVect();
+    const int* domhi = crse_geom.Domain().hiVect();
+
+    const int loVectXY[3] = {domlo[0]-1, domlo[1]-1, 0         };
+    const int hiVectXY[3] = {domhi[0]+1, domhi[1]+1, 0         };
+
+    const int loVectXZ[3] = {domlo[0]-1, 0         , domlo[2]-1};
+    const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
+
+    const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
+    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[2]+1};
+
+    const int bclo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
+    const int bchi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
+
+    IntVect smallEndXY( loVectXY );
+    IntVect bigEndXY  ( hiVectXY );
+    IntVect smallEndXZ( loVectXZ );
+    IntVect bigEndXZ  ( hiVectXZ );
+    IntVect smallEndYZ( loVectYZ );
+    IntVect bigEndYZ  ( hiVectYZ );
+
+    Box boxXY(smallEndXY, bigEndXY);
+    Box boxXZ(smallEndXZ, bigEndXZ);
+    Box boxYZ(smallEndYZ, bigEndYZ);
+
+    FArrayBox bcXYLo(boxXY);
+    FArrayBox bcXYHi(boxXY);
+    FArrayBox bcXZLo(boxXZ);
+    FArrayBox bcXZHi(boxXZ);
+    FArrayBox bcYZLo(boxYZ);
+    FArrayBox bcYZHi(boxYZ);
+
+    bcXYLo.setVal(0.0);
+    bcXYHi.setVal(0.0);
+    bcXZLo.setVal(0.0);
+    bcXZHi.setVal(0.0);
+    bcYZLo.setVal(0.0);
+    bcYZHi.setVal(0.0);
+
+    compute_direct_sum_bcs(crse_level, fine_level, Rhs, direct_sum_theta,
+			   bcXYLo, bcXYHi, bcXZLo, bcXZHi, bcYZLo, bcYZHi);
+
+    // In verification mode, compare the tree evaluation with the exact sum.
+
+    if (direct_sum_theta > 0.0 && direct_sum_verify == 1)
+    {
+	FArrayBox exXYLo(boxXY), exXYHi(boxXY);
+	FArrayBox exXZLo(boxXZ), exXZHi(boxXZ);
+	FArrayBox exYZLo(boxYZ), exYZHi(boxYZ);
+
+	exXYLo.setVal(0.0);
+	exXYHi.setVal(0.0);
+	exXZLo.setVal(0.0);
+	exXZHi.setVal(0.0);
+	exYZLo.setVal(0.0);
+	exYZHi.setVal(0.0);
+
+	compute_direct_sum_bcs(crse_level, fine_level, Rhs, 0.0,
+			       exXYLo, exXYHi, exXZLo, exXZHi, exYZLo, exYZHi);
+
+	const FArrayBox* tree[6]  = { &bcXYLo, &bcXYHi, &bcXZLo, &bcXZHi, &bcYZLo, &bcYZHi };
+	const FArrayBox* exact[6] = { &exXYLo, &exXYHi, &exXZLo, &exXZHi, &exYZLo, &exYZHi };
+
+	Real max_err = 0.0;
+	Real max_phi = 0.0;
+
+	for (int f = 0; f < 6; ++f) {
+	    const long npts = exact[f]->box().numPts();
+	    const Real* pt = tree[f]->dataPtr();
+	    const Real* pe = exact[f]->dataPtr();
+	    for (long i = 0; i < npts; ++i) {
+		max_err = std::max(max_err, std::abs(pt[i] - pe[i]));
+		max_phi = std::max(max_phi, std::abs(pe[i]));
+	    }
+	}
+
+	if (ParallelDescriptor::IOProcessor())
+	    std::cout << "Gravity::fill_direct_sum_BCs(): max relative error of the tree BCs with theta = "
+		      << direct_sum_theta << " is " << (max_phi > 0.0 ? max_err / max_phi : 0.0) << std::endl;
+    }
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -2049,6 +2256,201 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const PArray<MultiF
     }
 
 }
+
+void
+Gravity::make_multipole_gravity(int level, Real time, MultiFab& grav_vector, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::make_multipole_gravity()");
+
+    const Real strt = ParallelDescriptor::second();
+
+    // The moments are binned in radius with the coarse zone width, out to
+    // the domain corner farthest from the center.
+
+    const Real* dx0 = parent->Geom(0).CellSize();
+    const Real dr = dx0[0];
+
+    Real center[3];
+    get_center(center);
+
+    Real rmax_domain = 0.0;
+
+    for (int c = 0; c < 8; ++c) {
+	Real r2 = 0.0;
+	for (int dir = 0; dir < 3; ++dir) {
+	    const Real x = ((c >> dir) & 1) ? Geometry::ProbHi(dir) : Geometry::ProbLo(dir);
+	    r2 += (x - center[dir]) * (x - center[dir]);
+	}
+	rmax_domain = std::max(rmax_domain, std::sqrt(r2));
+    }
+
+    const int npts = int(rmax_domain / dr) + 2;
+
+    // The six moment arrays live in one buffer so that they can be
+    // reduced together.
+
+    const int n0 = (lnum + 1) * npts;
+    const int nC = (lnum + 1) * (lnum + 1) * npts;
+    const int nq = 2 * (n0 + 2 * nC);
+
+    Array<Real> q(nq, 0.0);
+
+    const int boundary_only = 0;
+
+    for (int lev = 0; lev <= level; ++lev)
+    {
+        const Real t_old = LevelData[lev].get_state_data(State_Type).prevTime();
+        const Real t_new = LevelData[lev].get_state_data(State_Type).curTime();
+        const Real eps   = (t_new - t_old) * 1.e-6;
+
+	MultiFab rho(grids[lev], 1, 0);
+
+	if ( eps == 0.0 || std::abs(time-t_new) < eps )
+	{
+	    MultiFab::Copy(rho, LevelData[lev].get_new_data(State_Type), Density, 0, 1, 0);
+	}
+        else if ( std::abs(time-t_old) < eps )
+        {
+	    MultiFab::Copy(rho, LevelData[lev].get_old_data(State_Type), Density, 0, 1, 0);
+        }
+        else if (time > t_old && time < t_new)
+        {
+            const Real alpha = (time - t_old)/(t_new - t_old);
+
+	    rho.setVal(0.0);
+	    MultiFab::Saxpy(rho, 1.0 - alpha, LevelData[lev].get_old_data(State_Type), Density, 0, 1, 0);
+	    MultiFab::Saxpy(rho, alpha, LevelData[lev].get_new_data(State_Type), Density, 0, 1, 0);
+        }
+        else
+        {
+     	    std::cout << " Level / Time in make_multipole_gravity is: " << lev << " " << time  << std::endl;
+      	    std::cout << " but old / new time      are: " << t_old << " " << t_new << std::endl;
+      	    BoxLib::Abort("Problem in Gravity::make_multipole_gravity");
+        }
+
+        if (lev < level)
+        {
+	    const MultiFab& mask = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)))->build_fine_mask();
+	    MultiFab::Multiply(rho, mask, 0, 0, 1, 0);
+        }
+
+        const Box& domain = parent->Geom(lev).Domain();
+	const Real* dx = parent->Geom(lev).CellSize();
+
+#ifdef _OPENMP
+	int nthreads = omp_get_max_threads();
+	PArray< Array<Real> > priv_q(nthreads, PArrayManage);
+	for (int i=0; i<nthreads; i++) {
+	    priv_q.set(i, new Array<Real>(nq, 0.0));
+	}
+#pragma omp parallel
+#endif
+	{
+#ifdef _OPENMP
+	    Real* qp = priv_q[omp_get_thread_num()].dataPtr();
+#else
+	    Real* qp = q.dataPtr();
+#endif
+	    for (MFIter mfi(rho,true); mfi.isValid(); ++mfi)
+	    {
+	        const Box& bx = mfi.tilebox();
+
+		ca_compute_multipole_moments(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+		                             ARLIM_3D(domain.loVect()), ARLIM_3D(domain.hiVect()),
+					     ZFILL(dx),BL_TO_FORTRAN_3D(rho[mfi]),
+					     BL_TO_FORTRAN_3D(volume[lev][mfi]),
+					     &lnum,
+					     qp, qp + n0, qp + n0 + nC,
+					     qp + n0 + 2*nC, qp + 2*n0 + 2*nC, qp + 2*n0 + 3*nC,
+					     &npts,&dr,&boundary_only);
+	    }
+
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp for
+	    for (int i=0; i<nq; ++i) {
+		for (int it=0; it<nthreads; it++) {
+		    q[i] += priv_q[it][i];
+		}
+	    }
+#endif
+	}
+
+    }
+
+    ParallelDescriptor::ReduceRealSum(q.dataPtr(), nq);
+
+    // Turn the moments of each bin into the interior moments of all bins up to
+    // and including it, and the exterior moments of it and all bins beyond.
+
+    Real* qL0 = q.dataPtr();
+    Real* qLC = qL0 + n0;
+    Real* qLS = qLC + nC;
+    Real* qU0 = qLS + nC;
+    Real* qUC = qU0 + n0;
+    Real* qUS = qUC + nC;
+
+    Real* qL[3] = { qL0, qLC, qLS };
+    Real* qU[3] = { qU0, qUC, qUS };
+    const int stride[3] = { lnum + 1, (lnum + 1) * (lnum + 1), (lnum + 1) * (lnum + 1) };
+
+    for (int a = 0; a < 3; ++a) {
+	const int s = stride[a];
+	for (int n = 1; n < npts; ++n)
+	    for (int i = 0; i < s; ++i)
+		qL[a][n*s+i] += qL[a][(n-1)*s+i];
+	for (int n = npts-2; n >= 0; --n)
+	    for (int i = 0; i < s; ++i)
+		qU[a][n*s+i] += qU[a][(n+1)*s+i];
+    }
+
+    // Evaluate phi everywhere on this level, including the ghost zones,
+    // and then difference it for the gravitational acceleration.
+
+    const Box& domain = parent->Geom(level).Domain();
+    const Real* dx = parent->Geom(level).CellSize();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(phi,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+        ca_put_multipole_phi(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+			     ARLIM_3D(domain.loVect()), ARLIM_3D(domain.hiVect()),
+			     ZFILL(dx), BL_TO_FORTRAN_3D(phi[mfi]),
+			     &lnum,
+			     qL0,qLC,qLS,qU0,qUC,qUS,
+			     &npts,&dr,&boundary_only);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(grav_vector,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+	ca_multipole_grav(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+			  ZFILL(dx), BL_TO_FORTRAN_3D(phi[mfi]),
+			  BL_TO_FORTRAN_3D(grav_vector[mfi]));
+    }
+
+    if (verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
+
+#ifdef BL_LAZY
+	Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "Gravity::make_multipole_gravity() time = " << end << std::endl;
+#ifdef BL_LAZY
+	});
+#endif
+    }
+}
 #endif
 
 #if (BL_SPACEDIM < 3)
@@ -2082,6 +2484,45 @@ Gravity::applyMetricTerms(int level, MultiFab& Rhs, PArray<MultiFab>& coeffs)
     }
 }
 
+void
+Gravity::applyMetricTermsRhs(int level, MultiFab& Rhs)
+{
+    const Real* dx = parent->Geom(level).CellSize();
+    int coord_type = Geometry::Coord();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(Rhs,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        ca_apply_metric_rhs(bx.loVect(), bx.hiVect(),
+			    BL_TO_FORTRAN(Rhs[mfi]),dx,&coord_type);
+    }
+}
+
+PArray<MultiFab>&
+Gravity::get_metric_coeffs(int level)
+{
+    // The metric-weighted coefficients only depend on the grids, so
+    // they are built on the first solve after the level is installed.
+
+    if (metric_coeffs[level].size() == 0)
+    {
+	metric_coeffs[level].resize(BL_SPACEDIM, PArrayManage);
+	for (int i = 0; i < BL_SPACEDIM ; i++) {
+	    metric_coeffs[level].set(i, new MultiFab(grids[level], 1, 0, Fab_allocate,
+						     IntVect::TheDimensionVector(i)));
+	    metric_coeffs[level][i].setVal(1.0);
+	}
+
+	MultiFab scratch(grids[level], 1, 0);
+	scratch.setVal(0.0);
+	applyMetricTerms(level, scratch, metric_coeffs[level]);
+    }
+
+    return metric_coeffs[level];
+}
+
 void
 Gravity::unweight_cc(int level, MultiFab& cc)
 {
@@ -2282,10 +2723,23 @@ Gravity::make_radial_gravity(int level, Real time, Array<Real>& radial_grav)
         const Real t_new = LevelData[lev].get_state_data(State_Type).curTime();
         const Real eps   = (t_new - t_old) * 1.e-6;
 
-	const int NUM_STATE = LevelData[lev].get_new_data(State_Type).nComp();
+        // We only need the density, except for the post-Newtonian
+        // correction, where the EOS needs the full state to get the pressure.
+
+#ifdef GR_GRAV
+	const int ncomp    = LevelData[lev].get_new_data(State_Type).nComp();
+	const int scomp    = 0;
+	const int rho_comp = Density;
+#else
+	const int ncomp    = 1;
+	const int scomp    = Density;
+	const int rho_comp = 0;
+#endif
+
+        MultiFab S(grids[lev],ncomp,0);
 
-        // Create MultiFab with NUM_STATE components and no ghost cells
-        MultiFab S(grids[lev],NUM_STATE,0);
+        const MultiFab& S_old = LevelData[lev].get_old_data(State_Type);
+        const MultiFab& S_new = LevelData[lev].get_new_data(State_Type);
 
 	if ( eps == 0.0 )
 	{
@@ -2293,29 +2747,24 @@ Gravity::make_radial_gravity(int level, Real time, Array<Real>& radial_grav)
             // dt is smaller than roundoff compared to the current time,
             // in which case we're probably in trouble anyway,
             // but we will still handle it gracefully here.
-            S.copy(LevelData[lev].get_new_data(State_Type),0,0,NUM_STATE);
+            MultiFab::Copy(S,S_new,scomp,0,ncomp,0);
 	}
         else if ( std::abs(time-t_old) < eps)
         {
-            S.copy(LevelData[lev].get_old_data(State_Type),0,0,NUM_STATE);
+            MultiFab::Copy(S,S_old,scomp,0,ncomp,0);
         }
         else if ( std::abs(time-t_new) < eps)
         {
-            S.copy(LevelData[lev].get_new_data(State_Type),0,0,NUM_STATE);
+            MultiFab::Copy(S,S_new,scomp,0,ncomp,0);
         }
         else if (time > t_old && time < t_new)
         {
             Real alpha   = (time - t_old)/(t_new - t_old);
             Real omalpha = 1.0 - alpha;
 
-            S.copy(LevelData[lev].get_old_data(State_Type),0,0,NUM_STATE);
+            MultiFab::Copy(S,S_old,scomp,0,ncomp,0);
             S.mult(omalpha);
-
-            MultiFab S_new(grids[lev],NUM_STATE,0);
-            S_new.copy(LevelData[lev].get_new_data(State_Type),0,0,NUM_STATE);
-            S_new.mult(alpha);
-
-            S.plus(S_new,0,NUM_STATE,0);
+            MultiFab::Saxpy(S,alpha,S_new,scomp,0,ncomp,0);
         }
         else
         {
@@ -2328,66 +2777,62 @@ Gravity::make_radial_gravity(int level, Real time, Array<Real>& radial_grav)
         {
 	    Castro* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
 	    const MultiFab& mask = fine_level->build_fine_mask();
-	    for (int n = 0; n < NUM_STATE; ++n)
+	    for (int n = 0; n < ncomp; ++n)
 		MultiFab::Multiply(S, mask, 0, n, 1, 0);
         }
 
         int n1d = radial_mass[lev].size();
 
-#ifdef GR_GRAV
-        for (int i = 0; i < n1d; i++) radial_pres[lev][i] = 0.;
-#endif
-        for (int i = 0; i < n1d; i++) radial_vol[lev][i] = 0.;
-        for (int i = 0; i < n1d; i++) radial_mass[lev][i] = 0.;
-
         const Geometry& geom = parent->Geom(lev);
         const Real* dx   = geom.CellSize();
         Real dr = dx[0] / double(drdxfac);
 
-#ifdef _OPENMP
-	int nthreads = omp_get_max_threads();
+        // The mass, volume (and pressure) bins go in one buffer so that
+        // they can be reduced together; each thread has its own copy.
+
 #ifdef GR_GRAV
-	PArray< Array<Real> > priv_radial_pres(nthreads, PArrayManage);
+	const int nbins = 3*n1d;
+#else
+	const int nbins = 2*n1d;
 #endif
-	PArray< Array<Real> > priv_radial_mass(nthreads, PArrayManage);
-	PArray< Array<Real> > priv_radial_vol (nthreads, PArrayManage);
-	for (int i=0; i<nthreads; i++) {
-#ifdef GR_GRAV
-	    priv_radial_pres.set(i, new Array<Real>(n1d,0.0));
+
+#ifdef _OPENMP
+	const int nthreads = omp_get_max_threads();
+#else
+	const int nthreads = 1;
 #endif
-	    priv_radial_mass.set(i, new Array<Real>(n1d,0.0));
-	    priv_radial_vol.set (i, new Array<Real>(n1d,0.0));
-	}
+
+	radial_bins.resize(nbins);
+	priv_radial_bins.resize(nthreads*nbins);
+
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
 	{
 #ifdef _OPENMP
-	    int tid = omp_get_thread_num();
+	    const int tid = omp_get_thread_num();
+#else
+	    const int tid = 0;
 #endif
+	    Real* bins = priv_radial_bins.dataPtr() + tid*nbins;
+
+	    for (int i = 0; i < nbins; i++)
+		bins[i] = 0.0;
+
 	    for (MFIter mfi(S,true); mfi.isValid(); ++mfi)
 	    {
 	        const Box& bx = mfi.tilebox();
 		FArrayBox& fab = S[mfi];
 
 		ca_compute_radial_mass(bx.loVect(), bx.hiVect(), dx, &dr,
-				       BL_TO_FORTRAN(fab),
-#ifdef _OPENMP
-				       priv_radial_mass[tid].dataPtr(),
-				       priv_radial_vol[tid].dataPtr(),
-#else
-				       radial_mass[lev].dataPtr(),
-				       radial_vol[lev].dataPtr(),
-#endif
+				       BL_TO_FORTRAN_N(fab,rho_comp),
+				       bins, bins + n1d,
 				       geom.ProbLo(),&n1d,&drdxfac,&lev);
 
 #ifdef GR_GRAV
 		ca_compute_avgpres(bx.loVect(), bx.hiVect(), dx, &dr,
 				   BL_TO_FORTRAN(fab),
-#ifdef _OPENMP
-				   priv_radial_pres[tid].dataPtr(),
-#else
-				   radial_pres[lev].dataPtr(),
-#endif
+				   bins + 2*n1d,
 				   geom.ProbLo(),&n1d,&drdxfac,&lev);
 #endif
 	    }
@@ -2395,23 +2840,23 @@ Gravity::make_radial_gravity(int level, Real time, Array<Real>& radial_grav)
 #ifdef _OPENMP
 #pragma omp barrier
 #pragma omp for
-	    for (int i=0; i<n1d; i++) {
-		for (int it=0; it<nthreads; it++) {
-#ifdef GR_GRAV
-	            radial_pres[lev][i] += priv_radial_pres[it][i];
 #endif
-	            radial_mass[lev][i] += priv_radial_mass[it][i];
-		    radial_vol [lev][i] += priv_radial_vol [it][i];
-		}
+	    for (int i=0; i<nbins; i++) {
+		radial_bins[i] = 0.0;
+		for (int it=0; it<nthreads; it++)
+		    radial_bins[i] += priv_radial_bins[it*nbins+i];
 	    }
-#endif
 	}
 
-        ParallelDescriptor::ReduceRealSum(radial_mass[lev].dataPtr() ,n1d);
-        ParallelDescriptor::ReduceRealSum(radial_vol[lev].dataPtr()  ,n1d);
+        ParallelDescriptor::ReduceRealSum(radial_bins.dataPtr(), nbins);
+
+        for (int i = 0; i < n1d; i++) {
+            radial_mass[lev][i] = radial_bins[i];
+            radial_vol [lev][i] = radial_bins[n1d+i];
 #ifdef GR_GRAV
-        ParallelDescriptor::ReduceRealSum(radial_pres[lev].dataPtr()  ,n1d);
+            radial_pres[lev][i] = radial_bins[2*n1d+i];
 #endif
+        }
 
         if (do_diag > 0)
         {
@@ -2627,14 +3072,12 @@ Gravity::solve_phi_with_fmg (int crse_level, int fine_level,
     {
 	for (int ilev = 0; ilev < nlevs; ++ilev) {
 	    int amr_lev = ilev + crse_level;
-	    coeffs[ilev].resize(BL_SPACEDIM, PArrayManage);
-	    for (int i = 0; i < BL_SPACEDIM ; i++) {
-		coeffs[ilev].set(i, new MultiFab(grids[amr_lev], 1, 0, Fab_allocate,
-						 IntVect::TheDimensionVector(i)));
-		coeffs[ilev][i].setVal(1.0);
-	    }
+	    PArray<MultiFab>& mc = get_metric_coeffs(amr_lev);
+	    coeffs[ilev].resize(BL_SPACEDIM);
+	    for (int i = 0; i < BL_SPACEDIM ; i++)
+		coeffs[ilev].set(i, &mc[i]);
 
-	    applyMetricTerms(amr_lev, rhs[ilev], coeffs[ilev]);
+	    applyMetricTermsRhs(amr_lev, rhs[ilev]);
 	}
 
 	fmg.set_gravity_coeffs(coeffs);
@@ -2791,23 +3234,8 @@ Gravity::update_max_rhs()
 #if (BL_SPACEDIM < 3)
     if (Geometry::IsSPHERICAL() || Geometry::IsRZ() )
     {
-	Array<PArray<MultiFab> > coeffs(nlevs);
-
-	for (int lev = 0; lev < nlevs; ++lev) {
-
-	    // We need to include this bit about the coefficients because
-	    // it's required by applyMetricTerms.
-
-	    coeffs[lev].resize(BL_SPACEDIM, PArrayManage);
-
-	    for (int i = 0; i < BL_SPACEDIM ; i++) {
-		coeffs[lev].set(i, new MultiFab(grids[lev], 1, 0, Fab_allocate,
-                                                IntVect::TheDimensionVector(i)));
-		coeffs[lev][i].setVal(1.0);
-	    }
-
-	    applyMetricTerms(lev, rhs[lev], coeffs[lev]);
-	}
+	for (int lev = 0; lev < nlevs; ++lev)
+	    applyMetricTermsRhs(lev, rhs[lev]);
     }
 #endif
 
@@ -52,6 +52,7 @@ HypreABec::HypreABec(const BoxArray& grids, const Geometry& _geom,
   pfmg_relax_type = 1; pp.query("pfmg_relax_type", pfmg_relax_type);
   verbose = 0; pp.query("v", verbose); pp.query("verbose", verbose);
   verbose_threshold = 0; pp.query("verbose_threshold", verbose_threshold);
+  setup_reuse = 0; pp.query("setup_reuse", setup_reuse);
 
   static int first = 1;
   if (verbose >= 1 && first && ParallelDescriptor::IOProcessor()) {
@@ -61,6 +62,7 @@ HypreABec::HypreABec(const BoxArray& grids, const Geometry& _geom,
     }
     std::cout << "habec.verbose                   = " << verbose << std::endl;
     std::cout << "habec.verbose_threshold         = " << verbose_threshold << std::endl;
+    std::cout << "habec.setup_reuse               = " << setup_reuse << std::endl;
   }
   bho = 0; // higher order boundaries don't work with symmetric matrices
 
@@ -218,10 +220,30 @@ HypreABec::HypreABec(const BoxArray& grids, const Geometry& _geom,
   }
 
   SPa = 0;
+
+  stencil = 0;
+  if (solver_flag == 7) {
+    stencil = new MultiFab(grids, BL_SPACEDIM + 1, 1);
+  }
+  cg_iters = 0;
+  cg_bnorm = 0.0;
+  cg_res   = 0.0;
+
+  bdp = NULL;
+
+  alpha = 0.0;
+  beta  = 0.0;
+
+  solver_built   = false;
+  matrix_changed = true;
+  reused_setups  = 0;
+  solver_maxiter = 0;
 }
 
 HypreABec::~HypreABec()
 {
+  clearSolver();
+
   delete acoefs;
   for (int i = 0; i < BL_SPACEDIM; i++) {
     delete bcoefs[i];
@@ -229,6 +251,8 @@ HypreABec::~HypreABec()
 
   delete SPa;
 
+  delete stencil;
+
   HYPRE_StructVectorDestroy(b);
   HYPRE_StructVectorDestroy(x);
 
@@ -238,8 +262,38 @@ HypreABec::~HypreABec()
   HYPRE_StructGridDestroy(grid);
 }
 
+// Copy the first component of src into dest (valid region only), and
+// return whether that changed any value in dest.
+
+static bool copyChanged(MultiFab& dest, const MultiFab& src)
+{
+  bool changed = false;
+
+  for (MFIter mfi(dest); mfi.isValid(); ++mfi) {
+    const Box& reg = mfi.validbox();
+    FArrayBox& d = dest[mfi];
+    const FArrayBox& f = src[mfi];
+
+    if (!changed) {
+      for (IntVect iv = reg.smallEnd(); iv <= reg.bigEnd(); reg.next(iv)) {
+        if (d(iv) != f(iv)) {
+          changed = true;
+          break;
+        }
+      }
+    }
+
+    d.copy(f, reg, 0, reg, 0, 1);
+  }
+
+  return changed;
+}
+
 void HypreABec::setScalars(Real Alpha, Real Beta)
 {
+  if (Alpha != alpha || Beta != beta) {
+    matrix_changed = true;
+  }
   alpha = Alpha;
   beta  = Beta;
 }
@@ -248,14 +302,18 @@ void HypreABec::aCoefficients(const MultiFab &a)
 {
   BL_ASSERT( a.ok() );
   BL_ASSERT( a.boxArray() == acoefs->boxArray() );
-  MultiFab::Copy(*acoefs, a, 0, 0, 1, 0);
+  if (copyChanged(*acoefs, a)) {
+    matrix_changed = true;
+  }
 }
  
 void HypreABec::bCoefficients(const MultiFab &b, int dir)
 {
   BL_ASSERT( b.ok() );
   BL_ASSERT( b.boxArray() == bcoefs[dir]->boxArray() );
-  MultiFab::Copy(*bcoefs[dir], b, 0, 0, 1, 0);
+  if (copyChanged(*bcoefs[dir], b)) {
+    matrix_changed = true;
+  }
 }
 
 void HypreABec::SPalpha(const MultiFab& a)
@@ -264,8 +322,11 @@ void HypreABec::SPalpha(const MultiFab& a)
   if (SPa == 0) {
     const BoxArray& grids = a.boxArray(); 
     SPa = new MultiFab(grids,1,0);
+    matrix_changed = true;
+  }
+  if (copyChanged(*SPa, a)) {
+    matrix_changed = true;
   }
-  MultiFab::Copy(*SPa, a, 0, 0, 1, 0);
 }
 
 void HypreABec::apply(MultiFab& product, MultiFab& vector, int icomp,
@@ -553,6 +614,49 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 {
   BL_PROFILE("HypreABec::setupSolver");
 
+  reltol = _reltol;
+  abstol = _abstol; // may be used to change tolerance for solve
+
+  // Only reload the matrix if a coefficient, scalar or boundary has
+  // changed since the last setup.  The setters only see the local
+  // data, so make the decision collectively.
+
+  ParallelDescriptor::ReduceBoolOr(matrix_changed);
+
+  if (matrix_changed || !solver_built) {
+    loadMatrix();
+  }
+
+  // Keep the solver setup if the matrix hasn't changed, or if we are
+  // allowed to use it for a few more matrices.
+
+  if (solver_built && maxiter != solver_maxiter) {
+    clearSolver();
+  }
+
+  if (solver_built && matrix_changed) {
+    if (reused_setups < setup_reuse) {
+      reused_setups++;
+    }
+    else {
+      clearSolver();
+    }
+  }
+
+  if (solver_built) {
+    setSolverTol(reltol); // solve may have loosened it last time
+  }
+  else {
+    createSolver(maxiter);
+  }
+
+  matrix_changed = false;
+}
+
+void HypreABec::loadMatrix()
+{
+  BL_PROFILE("HypreABec::loadMatrix");
+
   const BoxArray& grids = acoefs->boxArray();
 
   const int size = BL_SPACEDIM + 1;
@@ -567,6 +671,10 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
   Array<Real> r;
   Real foo=1.e200;
 
+  if (solver_flag == 7) {
+    stencil->setVal(0.0); // ghost cells not next to another grid stay 0
+  }
+
   Real *mat;
   for (MFIter ai(*acoefs); ai.isValid(); ++ai) {
     i = ai.index();
@@ -639,12 +747,25 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
     // initialize matrix
 
-    HYPRE_StructMatrixSetBoxValues(A, loV(reg), hiV(reg),
-				   size, stencil_indices, mat);
+    if (solver_flag == 7) {
+      hmfmat(mat, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+	     BL_TO_FORTRAN((*stencil)[ai]));
+    }
+    else {
+      HYPRE_StructMatrixSetBoxValues(A, loV(reg), hiV(reg),
+				     size, stencil_indices, mat);
+    }
 
     hypre_TFree(mat);
   }
 
+  if (solver_flag == 7) {
+    // The off-diagonal entries for the high side of each grid are
+    // stored in the neighboring grid.
+    stencil->FillBoundary(geom.periodicity());
+    return;
+  }
+
   HYPRE_StructMatrixAssemble(A);
 
 
@@ -658,9 +779,11 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
   HYPRE_StructVectorAssemble(b); // currently a no-op
   HYPRE_StructVectorAssemble(x); // currently a no-op
+}
 
-  reltol = _reltol;
-  abstol = _abstol; // may be used to change tolerance for solve
+void HypreABec::createSolver(int maxiter)
+{
+  BL_PROFILE("HypreABec::createSolver");
 
   if (solver_flag == 0) {
     HYPRE_StructSMGCreate(MPI_COMM_WORLD, &solver);
@@ -798,16 +921,45 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
     HYPRE_StructHybridSetup(solver, A, b, x);
   }
+  else if (solver_flag == 7) {
+    // nothing to set up beyond the stencil
+  }
   else {
     std::cout << "HypreABec: no such solver" << std::endl;
     exit(1);
   }
+
+  solver_built   = true;
+  solver_maxiter = maxiter;
+  reused_setups  = 0;
+}
+
+void HypreABec::setSolverTol(Real tol)
+{
+  if (solver_flag == 0) {
+    HYPRE_StructSMGSetTol(solver, tol);
+  }
+  else if(solver_flag == 1) {
+    HYPRE_StructPFMGSetTol(solver, tol);
+  }
+  else if(solver_flag == 2) {
+    // nothing for this option
+  }
+  else if(solver_flag == 3 || solver_flag == 4) {
+    HYPRE_StructPCGSetTol(solver, tol);
+  }
 }
 
 void HypreABec::clearSolver()
 {
   BL_PROFILE("HypreABec::clearSolver");
 
+  if (!solver_built) {
+    return;
+  }
+
+  solver_built = false;
+
   if (solver_flag == 0) {
     HYPRE_StructSMGDestroy(solver);
   }
@@ -839,18 +991,65 @@ void HypreABec::clearSolver()
   }
 }
 
+void HypreABec::bndryRhs(Real* vec, const MFIter& mfi)
+{
+  int i = mfi.index();
+  const Box &reg = acoefs->boxArray()[i];
+
+  Array<Real> r;
+
+  const NGBndry& bd = getBndry();
+  const Box& domain = bd.getDomain();
+  for (OrientationIter oitr; oitr; oitr++) {
+    int cdir(oitr());
+    int idim = oitr().coordDir();
+    const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+    const Real      &bcl = bd.bndryLocs(oitr())[i];
+    const FArrayBox       &fs  = bd.bndryValues(oitr())[mfi];
+    const Mask      &msk = bd.bndryMasks(oitr())[i];
+
+    if (reg[oitr()] == domain[oitr()]) {
+      const int *tfp = NULL;
+      int bctype = bct;
+      if (bd.mixedBndry(oitr())) {
+	const BaseFab<int> &tf = bd.bndryTypes(oitr())[i];
+	tfp = tf.dataPtr();
+	bctype = -1;
+      }
+      getFaceMetric(r, reg, oitr(), geom);
+      hbvec3(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+	     cdir, bctype, tfp, bho, bcl,
+	     BL_TO_FORTRAN_N(fs, bdcomp),
+	     BL_TO_FORTRAN(msk),
+	     BL_TO_FORTRAN((*bcoefs[idim])[mfi]),
+	     beta, dx, r.dataPtr());
+    }
+    else {
+      hbvec(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+	    cdir, bct, bho, bcl,
+	    BL_TO_FORTRAN_N(fs, bdcomp),
+	    BL_TO_FORTRAN(msk),
+	    BL_TO_FORTRAN((*bcoefs[idim])[mfi]),
+	    beta, dx);
+    }
+  }
+}
+
 void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
 {
   BL_PROFILE("HypreABec::solve");
 
+  if (solver_flag == 7) {
+    solveCG(dest, icomp, rhs, inhom);
+    return;
+  }
+
   const BoxArray& grids = dest.boxArray();
 
-  int i, idim;
+  int i;
 
   //dest.setVal(0.0);
 
-  Array<Real> r;
-
   Real *vec;
   for (MFIter di(dest); di.isValid(); ++di) {
     i = di.index();
@@ -878,42 +1077,7 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
     // add b.c.'s to rhs
 
     if (inhom) {
-      const NGBndry& bd = getBndry();
-      const Box& domain = bd.getDomain();
-      for (OrientationIter oitr; oitr; oitr++) {
-	int cdir(oitr());
-	idim = oitr().coordDir();
-	const RadBoundCond &bct = bd.bndryConds(oitr())[i];
-	const Real      &bcl = bd.bndryLocs(oitr())[i];
-	const FArrayBox       &fs  = bd.bndryValues(oitr())[di];
-	const Mask      &msk = bd.bndryMasks(oitr())[i];
-	const Box &bbox = (*bcoefs[idim])[di].box();
-
-        if (reg[oitr()] == domain[oitr()]) {
-          const int *tfp = NULL;
-          int bctype = bct;
-          if (bd.mixedBndry(oitr())) {
-            const BaseFab<int> &tf = bd.bndryTypes(oitr())[i];
-            tfp = tf.dataPtr();
-            bctype = -1;
-          }
-          getFaceMetric(r, reg, oitr(), geom);
-	  hbvec3(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-		 cdir, bctype, tfp, bho, bcl,
-		 BL_TO_FORTRAN_N(fs, bdcomp),
-		 BL_TO_FORTRAN(msk),
-		 BL_TO_FORTRAN((*bcoefs[idim])[di]),
-		 beta, dx, r.dataPtr());
-	}
-	else {
-	  hbvec(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-		cdir, bct, bho, bcl,
-		BL_TO_FORTRAN_N(fs, bdcomp),
-		BL_TO_FORTRAN(msk),
-		BL_TO_FORTRAN((*bcoefs[idim])[di]),
-		beta, dx);
-	}
-      }
+      bndryRhs(vec, di);
     }
 
     // initialize rhs
@@ -945,38 +1109,23 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
 		       : reltol);
 
     if (reltol_new > reltol) {
-      if (solver_flag == 0) {
-	HYPRE_StructSMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 1) {
-	HYPRE_StructPFMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 2) {
-	// nothing for this option
-      }
-      else if(solver_flag == 3 || solver_flag == 4) {
-	HYPRE_StructPCGSetTol(solver, reltol_new);
-      }
+      setSolverTol(reltol_new);
     }
   }
 
-  if (solver_flag == 0) {
-    HYPRE_StructSMGSolve(solver, A, b, x);
-    //HYPRE_StructVectorPrint("Xsmg", x, 0);
-    //HYPRE_StructVectorPrint("Bsmg", b, 0);
-    //cin.get();
-  }
-  else if (solver_flag == 1) {
-    HYPRE_StructPFMGSolve(solver, A, b, x);
-  }
-  else if (solver_flag == 2) {
-    HYPRE_StructJacobiSolve(solver, A, b, x);
-  }
-  else if (solver_flag == 3 || solver_flag == 4) {
-    HYPRE_StructPCGSolve(solver, A, b, x);
-  }
-  else if (solver_flag == 5 || solver_flag == 6) {
-    HYPRE_StructHybridSolve(solver, A, b, x);
+  solveSystem();
+
+  // If a setup built for another matrix wasn't good enough, redo the
+  // setup for this one and carry on from where the solve stopped.
+
+  if (reused_setups > 0 && getNumIterations() >= solver_maxiter) {
+    if (verbose >= 1 && ParallelDescriptor::IOProcessor()) {
+      std::cout << "HypreABec: reused solver setup did not converge, redoing setup" << std::endl;
+    }
+    int maxiter = solver_maxiter;
+    clearSolver();
+    createSolver(maxiter);
+    solveSystem();
   }
 
   for (MFIter di(dest); di.isValid(); ++di) {
@@ -1005,26 +1154,21 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
   }
 
   if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
-    int num_iterations;
+    int num_iterations = getNumIterations();
     Real res;
     if (solver_flag == 0) {
-      HYPRE_StructSMGGetNumIterations(solver, &num_iterations);
       HYPRE_StructSMGGetFinalRelativeResidualNorm(solver, &res);
     }
     else if(solver_flag == 1) {
-      HYPRE_StructPFMGGetNumIterations(solver, &num_iterations);
       HYPRE_StructPFMGGetFinalRelativeResidualNorm(solver, &res);
     }
     else if(solver_flag == 2) {
-      HYPRE_StructJacobiGetNumIterations(solver, &num_iterations);
       HYPRE_StructJacobiGetFinalRelativeResidualNorm(solver, &res);
     }
     else if(solver_flag == 3 || solver_flag == 4) {
-      HYPRE_StructPCGGetNumIterations(solver, &num_iterations);
       HYPRE_StructPCGGetFinalRelativeResidualNorm(solver, &res);
     }
     else if(solver_flag == 5 || solver_flag == 6) {
-      HYPRE_StructHybridGetNumIterations(solver, &num_iterations);
       HYPRE_StructHybridGetFinalRelativeResidualNorm(solver, &res);
     }
     if (num_iterations >= verbose_threshold) {
@@ -1037,10 +1181,65 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
   }
 }
 
+void HypreABec::solveSystem()
+{
+  if (solver_flag == 0) {
+    HYPRE_StructSMGSolve(solver, A, b, x);
+    //HYPRE_StructVectorPrint("Xsmg", x, 0);
+    //HYPRE_StructVectorPrint("Bsmg", b, 0);
+    //cin.get();
+  }
+  else if (solver_flag == 1) {
+    HYPRE_StructPFMGSolve(solver, A, b, x);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_StructJacobiSolve(solver, A, b, x);
+  }
+  else if (solver_flag == 3 || solver_flag == 4) {
+    HYPRE_StructPCGSolve(solver, A, b, x);
+  }
+  else if (solver_flag == 5 || solver_flag == 6) {
+    HYPRE_StructHybridSolve(solver, A, b, x);
+  }
+}
+
+int HypreABec::getNumIterations()
+{
+  int num_iterations = 0;
+  if (solver_flag == 0) {
+    HYPRE_StructSMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 1) {
+    HYPRE_StructPFMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 2) {
+    HYPRE_StructJacobiGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 3 || solver_flag == 4) {
+    HYPRE_StructPCGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 5 || solver_flag == 6) {
+    HYPRE_StructHybridGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 7) {
+    num_iterations = cg_iters;
+  }
+  return num_iterations;
+}
+
 Real HypreABec::getAbsoluteResidual()
 {
   BL_PROFILE("HypreABec::getAbsoluteResidual");
 
+  if (solver_flag == 7) {
+    const BoxArray& grids = acoefs->boxArray();
+    Real volume = 0.0;
+    for (int i = 0; i < grids.size(); i++) {
+      volume += grids[i].numPts();
+    }
+    return cg_bnorm * cg_res / sqrt(volume);
+  }
+
   Real bnorm;
   bnorm = hypre_StructInnerProd((hypre_StructVector *) b,
 				(hypre_StructVector *) b);
@@ -1071,3 +1270,140 @@ Real HypreABec::getAbsoluteResidual()
 
   return bnorm * res / sqrt(volume);
 }
+
+Real HypreABec::applyStencil(MultiFab& y, MultiFab& x)
+{
+  BL_PROFILE("HypreABec::applyStencil");
+
+  x.FillBoundary(geom.periodicity());
+
+  Real xdoty = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:xdoty)
+#endif
+  for (MFIter mfi(y,true); mfi.isValid(); ++mfi) {
+    const Box& reg = mfi.tilebox();
+    Real s;
+    hmfapply(BL_TO_FORTRAN(y[mfi]),
+	     BL_TO_FORTRAN(x[mfi]),
+	     BL_TO_FORTRAN((*stencil)[mfi]),
+	     ARLIM(reg.loVect()), ARLIM(reg.hiVect()), s);
+    xdoty += s;
+  }
+
+  ParallelDescriptor::ReduceRealSum(xdoty);
+
+  return xdoty;
+}
+
+void HypreABec::jacobiPrecond(MultiFab& z, const MultiFab& r,
+			      Real& rdotz, Real& rdotr)
+{
+  BL_PROFILE("HypreABec::jacobiPrecond");
+
+  Real rz = 0.0, rr = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:rz,rr)
+#endif
+  for (MFIter mfi(z,true); mfi.isValid(); ++mfi) {
+    const Box& reg = mfi.tilebox();
+    Real s1, s2;
+    hmfjacobi(BL_TO_FORTRAN(z[mfi]),
+	      BL_TO_FORTRAN(r[mfi]),
+	      BL_TO_FORTRAN((*stencil)[mfi]),
+	      ARLIM(reg.loVect()), ARLIM(reg.hiVect()), s1, s2);
+    rz += s1;
+    rr += s2;
+  }
+
+  Real sums[2] = { rz, rr };
+  ParallelDescriptor::ReduceRealSum(sums, 2);
+  rdotz = sums[0];
+  rdotr = sums[1];
+}
+
+// Jacobi-preconditioned conjugate gradients with the stencil built by
+// loadMatrix.  Everything stays in MultiFabs, so there is none of the
+// copying into and out of Hypre vectors of the other solvers.  The
+// convergence test is the same as Hypre's: the 2-norm of the residual
+// relative to that of the rhs (including b.c. contributions).
+
+void HypreABec::solveCG(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
+{
+  BL_PROFILE("HypreABec::solveCG");
+
+  const BoxArray& grids = acoefs->boxArray();
+
+  // The ghost cells of phi and p are only filled from other grids, the
+  // rest stay 0 where the stencil has no neighbor anyway.
+  MultiFab phi(grids, 1, 1), p(grids, 1, 1);
+  MultiFab r(grids, 1, 0), z(grids, 1, 0), q(grids, 1, 0);
+  phi.setVal(0.0);
+  p.setVal(0.0);
+
+  MultiFab::Copy(phi, dest, icomp, 0, 1, 0);
+
+  for (MFIter ri(r); ri.isValid(); ++ri) {
+    r[ri].copy(rhs[ri], 0, 0, 1);
+    if (inhom) {
+      bndryRhs(r[ri].dataPtr(), ri);
+    }
+  }
+
+  Real rz, rr;
+  jacobiPrecond(z, r, rz, rr);
+  cg_bnorm = sqrt(rr);
+
+  Real tol = reltol;
+  if (abstol > 0.0 && cg_bnorm > 0.0) {
+    Real volume = 0.0;
+    for (int i = 0; i < grids.size(); i++) {
+      volume += grids[i].numPts();
+    }
+    tol = std::max(reltol, abstol / cg_bnorm * sqrt(volume));
+  }
+
+  // r = b - A phi
+  applyStencil(q, phi);
+  MultiFab::Subtract(r, q, 0, 0, 1, 0);
+
+  jacobiPrecond(z, r, rz, rr);
+  MultiFab::Copy(p, z, 0, 0, 1, 0);
+
+  cg_iters = 0;
+  while (sqrt(rr) > tol * cg_bnorm && cg_iters < solver_maxiter) {
+    cg_iters++;
+
+    Real pq = applyStencil(q, p);
+    if (pq == 0.0) {
+      break;
+    }
+    Real alpha_cg = rz / pq;
+
+    MultiFab::Saxpy(phi, alpha_cg, p, 0, 0, 1, 0);
+    MultiFab::Saxpy(r,  -alpha_cg, q, 0, 0, 1, 0);
+
+    Real rz_old = rz;
+    jacobiPrecond(z, r, rz, rr);
+
+    Real beta_cg = rz / rz_old;
+    p.mult(beta_cg, 0, 1, 0);
+    MultiFab::Add(p, z, 0, 0, 1, 0);
+  }
+
+  cg_res = (cg_bnorm > 0.0) ? sqrt(rr) / cg_bnorm : 0.0;
+
+  MultiFab::Copy(dest, phi, 0, icomp, 1, 0);
+
+  if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+    if (cg_iters >= verbose_threshold) {
+      int oldprec = std::cout.precision(20);
+      std::cout << cg_iters
+           << " Jacobi-CG Iterations, Relative Residual "
+           << cg_res << std::endl;
+      std::cout.precision(oldprec);
+    }
+  }
+}
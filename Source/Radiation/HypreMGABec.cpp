@@ -0,0 +1,728 @@
+
+#include <ParmParse.H>
+#include <LO_BCTYPES.H>
+
+#include "HypreMGABec.H"
+#include "HypreMultiABec.H"
+#include "HABEC_F.H"
+
+#include <iostream>
+
+#include "_hypre_sstruct_mv.h"
+
+static int ispow2(int i)
+{
+  return (i == 1) ? 1 : (((i <= 0) || (i & 1)) ? 0 : ispow2(i / 2));
+}
+
+#if (BL_SPACEDIM == 1)
+static int vl[2] = { 0, 0 };
+static int vh[2] = { 0, 0 };
+#endif
+
+static int* loV(const Box& b) {
+#if (BL_SPACEDIM == 1)
+  vl[0] = b.smallEnd(0);
+  return vl;
+#else
+  return (int*) b.loVect();
+#endif
+}
+
+static int* hiV(const Box& b) {
+#if (BL_SPACEDIM == 1)
+  vh[0] = b.bigEnd(0);
+  return vh;
+#else
+  return (int*) b.hiVect();
+#endif
+}
+
+HypreMGABec::HypreMGABec(const BoxArray& grids, const Geometry& _geom,
+			 int _ngroups, int _solver_flag)
+  : geom(_geom), ngroups(_ngroups), solver_flag(_solver_flag)
+{
+  ParmParse pp("habec");
+
+  pfmg_relax_type = 1; pp.query("pfmg_relax_type", pfmg_relax_type);
+  verbose = 0; pp.query("v", verbose); pp.query("verbose", verbose);
+  verbose_threshold = 0; pp.query("verbose_threshold", verbose_threshold);
+
+  bho = 0; // higher order boundaries don't work with symmetric matrices
+
+  for (int i = 0; i < BL_SPACEDIM; i++) {
+    dx[i] = geom.CellSize(i);
+  }
+
+  const int part = 0;
+
+#if (BL_SPACEDIM == 1)
+
+  // Hypre doesn't support 1D directly, so we use 2D Hypre with
+  // the second dimension collapsed.
+  // (SMG reduces to cyclic reduction in this case, so it's an exact solve.)
+  // (PFMG will not work.)
+
+  HYPRE_SStructGridCreate(MPI_COMM_WORLD, 2, 1, &grid);
+
+  if (geom.isAnyPeriodic()) {
+    BL_ASSERT(geom.isPeriodic(0));
+    BL_ASSERT(geom.Domain().smallEnd(0) == 0);
+
+    int is_periodic[2];
+    is_periodic[0] = geom.period(0);
+    is_periodic[1] = 0;
+    BL_ASSERT(ispow2(is_periodic[0]));
+
+    HYPRE_SStructGridSetPeriodic(grid, part, is_periodic);
+  }
+
+#else
+
+  HYPRE_SStructGridCreate(MPI_COMM_WORLD, BL_SPACEDIM, 1, &grid);
+
+  if (geom.isAnyPeriodic()) {
+    int is_periodic[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++) {
+      is_periodic[i] = 0;
+      if (geom.isPeriodic(i)) {
+	is_periodic[i] = geom.period(i);
+	BL_ASSERT(ispow2(is_periodic[i]));
+	BL_ASSERT(geom.Domain().smallEnd(i) == 0);
+      }
+    }
+    HYPRE_SStructGridSetPeriodic(grid, part, is_periodic);
+  }
+
+#endif
+
+  int num_procs = ParallelDescriptor::NProcs();
+  int myid      = ParallelDescriptor::MyProc();
+  DistributionMapping distributionMap(grids, num_procs);
+
+  for (int i = 0; i < grids.size(); i++) {
+    if (distributionMap[i] == myid) {
+      HYPRE_SStructGridSetExtents(grid, part, loV(grids[i]), hiV(grids[i]));
+    }
+  }
+
+  // One cell-centered variable per group
+  Array<HYPRE_SStructVariable> vars(ngroups, HYPRE_SSTRUCT_VARIABLE_CELL);
+  HYPRE_SStructGridSetVariables(grid, part, ngroups, vars.dataPtr());
+
+  HYPRE_SStructGridAssemble(grid);
+
+  // Same stencil as in HypreMultiABec, but each group only sees itself:
+
+#if (BL_SPACEDIM == 1)
+  // fake 1D as a 2D problem:
+  int offsets[3][2] = {{ 0,  0},
+		       {-1,  0},
+		       { 1,  0}};
+#elif (BL_SPACEDIM == 2)
+  int offsets[5][2] = {{ 0,  0},
+		       {-1,  0},
+		       { 1,  0},
+		       { 0, -1},
+		       { 0,  1}};
+#elif (BL_SPACEDIM == 3)
+  int offsets[7][3] = {{ 0,  0,  0},
+		       {-1,  0,  0},
+		       { 1,  0,  0},
+		       { 0, -1,  0},
+		       { 0,  1,  0},
+		       { 0,  0, -1},
+		       { 0,  0,  1}};
+#endif
+
+  HYPRE_SStructGraphCreate(MPI_COMM_WORLD, grid, &graph);
+  HYPRE_SStructGraphSetObjectType(graph, HYPRE_SSTRUCT);
+
+  for (int igroup = 0; igroup < ngroups; igroup++) {
+    HYPRE_SStructStencil stencil;
+#if (BL_SPACEDIM == 1)
+    HYPRE_SStructStencilCreate(2, 3, &stencil);
+#else
+    HYPRE_SStructStencilCreate(BL_SPACEDIM, 2 * BL_SPACEDIM + 1, &stencil);
+#endif
+    for (int i = 0; i < 2 * BL_SPACEDIM + 1; i++) {
+      HYPRE_SStructStencilSetEntry(stencil, i, offsets[i], igroup);
+    }
+    HYPRE_SStructGraphSetStencil(graph, part, igroup, stencil);
+    HYPRE_SStructStencilDestroy(stencil); // the graph keeps a reference
+  }
+
+  HYPRE_SStructGraphAssemble(graph);
+
+  HYPRE_SStructMatrixCreate(MPI_COMM_WORLD, graph, &A);
+  HYPRE_SStructMatrixSetObjectType(A, HYPRE_SSTRUCT);
+  HYPRE_SStructMatrixInitialize(A);
+
+  HYPRE_SStructVectorCreate(MPI_COMM_WORLD, grid, &b);
+  HYPRE_SStructVectorSetObjectType(b, HYPRE_SSTRUCT);
+
+  HYPRE_SStructVectorCreate(MPI_COMM_WORLD, grid, &x);
+  HYPRE_SStructVectorSetObjectType(x, HYPRE_SSTRUCT);
+
+  HYPRE_SStructVectorInitialize(b);
+  HYPRE_SStructVectorInitialize(x);
+
+  HYPRE_SStructVectorAssemble(b);
+  HYPRE_SStructVectorAssemble(x);
+
+  int ngrow = 0;
+  acoefs = new MultiFab(grids, ngroups, ngrow);
+  acoefs->setVal(0.0);
+
+  for (int i = 0; i < BL_SPACEDIM; i++) {
+    BoxArray edge_boxes(grids);
+    edge_boxes.surroundingNodes(i);
+    bcoefs[i] = new MultiFab(edge_boxes, ngroups, ngrow);
+  }
+
+  SPa = 0;
+
+  bdp = NULL;
+
+  alpha = 0.0;
+  beta  = 0.0;
+
+  solver_built   = false;
+  matrix_changed = true;
+  solver_maxiter = 0;
+}
+
+HypreMGABec::~HypreMGABec()
+{
+  clearSolver();
+
+  delete acoefs;
+  for (int i = 0; i < BL_SPACEDIM; i++) {
+    delete bcoefs[i];
+  }
+
+  delete SPa;
+
+  HYPRE_SStructVectorDestroy(b);
+  HYPRE_SStructVectorDestroy(x);
+
+  HYPRE_SStructMatrixDestroy(A);
+
+  HYPRE_SStructGraphDestroy(graph);
+  HYPRE_SStructGridDestroy(grid);
+}
+
+// Copy all of src into dest (valid region only), and return whether
+// that changed any value in dest.
+
+static bool copyChanged(MultiFab& dest, const MultiFab& src)
+{
+  BL_ASSERT(src.nComp() >= dest.nComp());
+
+  const int ncomp = dest.nComp();
+  bool changed = false;
+
+  for (MFIter mfi(dest); mfi.isValid(); ++mfi) {
+    const Box& reg = mfi.validbox();
+    FArrayBox& d = dest[mfi];
+    const FArrayBox& f = src[mfi];
+
+    for (int n = 0; n < ncomp && !changed; n++) {
+      for (IntVect iv = reg.smallEnd(); iv <= reg.bigEnd(); reg.next(iv)) {
+        if (d(iv,n) != f(iv,n)) {
+          changed = true;
+          break;
+        }
+      }
+    }
+
+    d.copy(f, reg, 0, reg, 0, ncomp);
+  }
+
+  return changed;
+}
+
+void HypreMGABec::setScalars(Real Alpha, Real Beta)
+{
+  if (Alpha != alpha || Beta != beta) {
+    matrix_changed = true;
+  }
+  alpha = Alpha;
+  beta  = Beta;
+}
+
+void HypreMGABec::aCoefficients(const MultiFab &a)
+{
+  BL_ASSERT( a.ok() );
+  BL_ASSERT( a.boxArray() == acoefs->boxArray() );
+  if (copyChanged(*acoefs, a)) {
+    matrix_changed = true;
+  }
+}
+
+void HypreMGABec::bCoefficients(const MultiFab &b, int dir)
+{
+  BL_ASSERT( b.ok() );
+  BL_ASSERT( b.boxArray() == bcoefs[dir]->boxArray() );
+  if (copyChanged(*bcoefs[dir], b)) {
+    matrix_changed = true;
+  }
+}
+
+void HypreMGABec::SPalpha(const MultiFab& a)
+{
+  BL_ASSERT( a.ok() );
+  if (SPa == 0) {
+    SPa = new MultiFab(a.boxArray(), ngroups, 0);
+    matrix_changed = true;
+  }
+  if (copyChanged(*SPa, a)) {
+    matrix_changed = true;
+  }
+}
+
+void HypreMGABec::boundaryFlux(MultiFab* Flux, MultiFab& Soln, int igroup,
+			       BC_Mode inhom)
+{
+    BL_PROFILE("HypreMGABec::boundaryFlux");
+
+    const BoxArray &grids = Soln.boxArray();
+
+    const NGBndry& bd = getBndry();
+    const Box& domain = bd.getDomain();
+
+    const Real flux_factor = HypreMultiABec::fluxFactor();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+	Array<Real> r;
+	Real foo=1.e200;
+
+	for (MFIter si(Soln); si.isValid(); ++si) {
+	    int i = si.index();
+	    const Box &reg = grids[i];
+	    for (OrientationIter oitr; oitr; oitr++) {
+		int cdir(oitr());
+		int idim = oitr().coordDir();
+		const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+		const Real      &bcl = bd.bndryLocs(oitr())[i];
+		const FArrayBox       &fs  = bd.bndryValues(oitr())[si];
+		const Mask      &msk = bd.bndryMasks(oitr())[i];
+
+		if (reg[oitr()] == domain[oitr()]) {
+		    const int *tfp = NULL;
+		    int bctype = bct;
+		    if (bd.mixedBndry(oitr())) {
+			const BaseFab<int> &tf = bd.bndryTypes(oitr())[i];
+			tfp = tf.dataPtr();
+			bctype = -1;
+		    }
+		    Real* pSPa;
+		    Box SPabox;
+		    if (SPa != 0) {
+			pSPa = (*SPa)[si].dataPtr(igroup);
+			SPabox = (*SPa)[si].box();
+		    }
+		    else {
+			pSPa = &foo;
+			SPabox = Box(IntVect::TheZeroVector(),IntVect::TheZeroVector());
+		    }
+		    HypreABec::getFaceMetric(r, reg, oitr(), geom);
+		    hbflx3(BL_TO_FORTRAN(Flux[idim][si]),
+			   BL_TO_FORTRAN_N(Soln[si], igroup),
+			   ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+			   cdir, bctype, tfp, bho, bcl,
+			   BL_TO_FORTRAN_N(fs, igroup),
+			   BL_TO_FORTRAN(msk),
+			   BL_TO_FORTRAN_N((*bcoefs[idim])[si], igroup),
+			   beta, dx, flux_factor, r.dataPtr(), inhom,
+			   pSPa, ARLIM(SPabox.loVect()), ARLIM(SPabox.hiVect()));
+		}
+		else {
+		    hbflx(BL_TO_FORTRAN(Flux[idim][si]),
+			  BL_TO_FORTRAN_N(Soln[si], igroup),
+			  ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+			  cdir, bct, bho, bcl,
+			  BL_TO_FORTRAN_N(fs, igroup),
+			  BL_TO_FORTRAN(msk),
+			  BL_TO_FORTRAN_N((*bcoefs[idim])[si], igroup),
+			  beta, dx, inhom);
+		}
+	    }
+	}
+    }
+}
+
+void HypreMGABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
+{
+  BL_PROFILE("HypreMGABec::setupSolver");
+
+  reltol = _reltol;
+  abstol = _abstol; // may be used to change tolerance for solve
+
+  ParallelDescriptor::ReduceBoolOr(matrix_changed);
+
+  if (matrix_changed || maxiter != solver_maxiter) {
+    clearSolver();
+  }
+
+  if (solver_built) {
+    setSolverTol(reltol); // solve may have loosened it last time
+  }
+  else {
+    loadMatrix();
+    createSolver(maxiter);
+  }
+
+  matrix_changed = false;
+}
+
+void HypreMGABec::loadMatrix()
+{
+  BL_PROFILE("HypreMGABec::loadMatrix");
+
+  const BoxArray& grids = acoefs->boxArray();
+
+  const int part = 0;
+  const int size = 2 * BL_SPACEDIM + 1;
+
+  int stencil_indices[size];
+
+  for (int i = 0; i < size; i++) {
+    stencil_indices[i] = i;
+  }
+
+  const Real flux_factor = HypreMultiABec::fluxFactor();
+
+  Array<Real> r;
+  Real foo=1.e200;
+
+  const NGBndry& bd = getBndry();
+  const Box& domain = bd.getDomain();
+
+  for (MFIter ai(*acoefs); ai.isValid(); ++ai) {
+    int i = ai.index();
+    const Box &reg = grids[i];
+
+    int volume = reg.numPts();
+    Real *mat = hypre_CTAlloc(double, size*volume);
+
+    for (int igroup = 0; igroup < ngroups; igroup++) {
+
+      // build matrix interior
+
+      hmac(mat,
+	   BL_TO_FORTRAN_N((*acoefs)[ai], igroup),
+	   ARLIM(reg.loVect()), ARLIM(reg.hiVect()), alpha);
+
+      for (int idim = 0; idim < BL_SPACEDIM; idim++) {
+	hmbc(mat,
+	     BL_TO_FORTRAN_N((*bcoefs[idim])[ai], igroup),
+	     ARLIM(reg.loVect()), ARLIM(reg.hiVect()), beta, dx, idim);
+      }
+
+      // add b.c.'s to matrix diagonal, and
+      // zero out offdiag values at domain boundaries
+
+      for (OrientationIter oitr; oitr; oitr++) {
+	int cdir(oitr());
+	int idim = oitr().coordDir();
+	const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+	const Real      &bcl = bd.bndryLocs(oitr())[i];
+	const Mask      &msk = bd.bndryMasks(oitr())[i];
+	if (reg[oitr()] == domain[oitr()]) {
+	  const int *tfp = NULL;
+	  int bctype = bct;
+	  if (bd.mixedBndry(oitr())) {
+	    const BaseFab<int> &tf = bd.bndryTypes(oitr())[i];
+	    tfp = tf.dataPtr();
+	    bctype = -1;
+	  }
+	  const Box &fsb = bd.bndryValues(oitr())[ai].box();
+	  Real* pSPa;
+	  Box SPabox;
+	  if (SPa != 0) {
+	    pSPa = (*SPa)[ai].dataPtr(igroup);
+	    SPabox = (*SPa)[ai].box();
+	  }
+	  else {
+	    pSPa = &foo;
+	    SPabox = Box(IntVect::TheZeroVector(),IntVect::TheZeroVector());
+	  }
+	  HypreABec::getFaceMetric(r, reg, oitr(), geom);
+	  hmmat3(mat, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+		 cdir, bctype, tfp, bho, bcl,
+		 ARLIM(fsb.loVect()), ARLIM(fsb.hiVect()),
+		 BL_TO_FORTRAN(msk),
+		 BL_TO_FORTRAN_N((*bcoefs[idim])[ai], igroup),
+		 beta, dx, flux_factor, r.dataPtr(),
+		 pSPa, ARLIM(SPabox.loVect()), ARLIM(SPabox.hiVect()));
+	}
+	else {
+	  hmmat(mat, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+		cdir, bct, bho, bcl,
+		BL_TO_FORTRAN(msk),
+		BL_TO_FORTRAN_N((*bcoefs[idim])[ai], igroup),
+		beta, dx);
+	}
+      }
+
+      // initialize matrix block of this group
+
+      HYPRE_SStructMatrixSetBoxValues(A, part, loV(reg), hiV(reg), igroup,
+				      size, stencil_indices, mat);
+    }
+
+    hypre_TFree(mat);
+  }
+
+  HYPRE_SStructMatrixAssemble(A);
+}
+
+void HypreMGABec::createSolver(int maxiter)
+{
+  BL_PROFILE("HypreMGABec::createSolver");
+
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitCreate(MPI_COMM_WORLD, &solver);
+    HYPRE_SStructSplitSetMaxIter(solver, maxiter);
+    HYPRE_SStructSplitSetTol(solver, reltol);
+    if (solver_flag == 0) {
+      HYPRE_SStructSplitSetStructSolver(solver, HYPRE_SMG);
+    }
+    else {
+      HYPRE_SStructSplitSetStructSolver(solver, HYPRE_PFMG);
+    }
+    HYPRE_SStructSplitSetup(solver, A, b, x);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGCreate(MPI_COMM_WORLD, &solver);
+    HYPRE_SStructSysPFMGSetMaxIter(solver, maxiter);
+    HYPRE_SStructSysPFMGSetRelChange(solver, 0);
+    HYPRE_SStructSysPFMGSetTol(solver, reltol);
+// weighted Jacobi = 1; red-black GS = 2
+    HYPRE_SStructSysPFMGSetRelaxType(solver, pfmg_relax_type);
+    HYPRE_SStructSysPFMGSetNumPreRelax(solver, 1);
+    HYPRE_SStructSysPFMGSetNumPostRelax(solver, 1);
+    HYPRE_SStructSysPFMGSetSkipRelax(solver, 0);
+    HYPRE_SStructSysPFMGSetLogging(solver, 1);
+    HYPRE_SStructSysPFMGSetup(solver, A, b, x);
+  }
+  else {
+    std::cout << "HypreMGABec: no such solver" << std::endl;
+    exit(1);
+  }
+
+  solver_built   = true;
+  solver_maxiter = maxiter;
+}
+
+void HypreMGABec::setSolverTol(Real tol)
+{
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitSetTol(solver, tol);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGSetTol(solver, tol);
+  }
+}
+
+void HypreMGABec::clearSolver()
+{
+  if (!solver_built) {
+    return;
+  }
+
+  solver_built = false;
+
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitDestroy(solver);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGDestroy(solver);
+  }
+}
+
+void HypreMGABec::solve(MultiFab& dest, MultiFab& rhs, BC_Mode inhom)
+{
+  BL_PROFILE("HypreMGABec::solve");
+
+  BL_ASSERT(dest.nComp() >= ngroups);
+  BL_ASSERT(rhs.nComp()  >= ngroups);
+
+  const BoxArray& grids = acoefs->boxArray();
+
+  const int part = 0;
+
+  Array<Real> r;
+
+  for (MFIter di(dest); di.isValid(); ++di) {
+    int i = di.index();
+    const Box &reg = grids[i];
+
+    FArrayBox f(reg);
+    Real* vec = f.dataPtr();
+
+    for (int igroup = 0; igroup < ngroups; igroup++) {
+
+      // initialize x with dest, then reuse the space to set up rhs:
+
+      f.copy(dest[di], igroup, 0, 1);
+      HYPRE_SStructVectorSetBoxValues(x, part, loV(reg), hiV(reg), igroup, vec);
+
+      f.copy(rhs[di], igroup, 0, 1);
+
+      // add b.c.'s to rhs
+
+      if (inhom) {
+	const NGBndry& bd = getBndry();
+	const Box& domain = bd.getDomain();
+	for (OrientationIter oitr; oitr; oitr++) {
+	  int cdir(oitr());
+	  int idim = oitr().coordDir();
+	  const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+	  const Real      &bcl = bd.bndryLocs(oitr())[i];
+	  const FArrayBox       &fs  = bd.bndryValues(oitr())[di];
+	  const Mask      &msk = bd.bndryMasks(oitr())[i];
+
+	  if (reg[oitr()] == domain[oitr()]) {
+	    const int *tfp = NULL;
+	    int bctype = bct;
+	    if (bd.mixedBndry(oitr())) {
+	      const BaseFab<int> &tf = bd.bndryTypes(oitr())[i];
+	      tfp = tf.dataPtr();
+	      bctype = -1;
+	    }
+	    HypreABec::getFaceMetric(r, reg, oitr(), geom);
+	    hbvec3(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+		   cdir, bctype, tfp, bho, bcl,
+		   BL_TO_FORTRAN_N(fs, igroup),
+		   BL_TO_FORTRAN(msk),
+		   BL_TO_FORTRAN_N((*bcoefs[idim])[di], igroup),
+		   beta, dx, r.dataPtr());
+	  }
+	  else {
+	    hbvec(vec, ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+		  cdir, bct, bho, bcl,
+		  BL_TO_FORTRAN_N(fs, igroup),
+		  BL_TO_FORTRAN(msk),
+		  BL_TO_FORTRAN_N((*bcoefs[idim])[di], igroup),
+		  beta, dx);
+	  }
+	}
+      }
+
+      // initialize rhs
+
+      HYPRE_SStructVectorSetBoxValues(b, part, loV(reg), hiV(reg), igroup, vec);
+    }
+  }
+
+  HYPRE_SStructVectorAssemble(b);
+  HYPRE_SStructVectorAssemble(x);
+
+  if (abstol > 0.0) {
+    Real bnorm;
+    hypre_SStructInnerProd((hypre_SStructVector *) b,
+                           (hypre_SStructVector *) b,
+                           &bnorm);
+    bnorm = sqrt(bnorm);
+
+    Real volume = 0.0;
+    for (int i = 0; i < grids.size(); i++) {
+      volume += grids[i].numPts();
+    }
+    volume *= ngroups;
+
+    Real reltol_new = (bnorm > 0.0
+		       ? abstol / bnorm * sqrt(volume)
+		       : reltol);
+
+    if (reltol_new > reltol) {
+      setSolverTol(reltol_new);
+    }
+  }
+
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitSolve(solver, A, b, x);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGSolve(solver, A, b, x);
+  }
+
+  HYPRE_SStructVectorGather(x);
+
+  for (MFIter di(dest); di.isValid(); ++di) {
+    int i = di.index();
+    const Box &reg = grids[i];
+
+    FArrayBox f(reg);
+
+    for (int igroup = 0; igroup < ngroups; igroup++) {
+      HYPRE_SStructVectorGetBoxValues(x, part, loV(reg), hiV(reg), igroup,
+				      f.dataPtr());
+      dest[di].copy(f, 0, igroup, 1);
+    }
+  }
+
+  if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+    int num_iterations = getNumIterations();
+    Real res = getRelativeResidual();
+    if (num_iterations >= verbose_threshold) {
+      int oldprec = std::cout.precision(20);
+      std::cout << "All " << ngroups << " groups: "
+                << num_iterations
+                << " Hypre Multigrid Iterations, Relative Residual "
+                << res << std::endl;
+      std::cout.precision(oldprec);
+    }
+  }
+}
+
+int HypreMGABec::getNumIterations()
+{
+  int num_iterations = 0;
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitGetNumIterations(solver, &num_iterations);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGGetNumIterations(solver, &num_iterations);
+  }
+  return num_iterations;
+}
+
+Real HypreMGABec::getRelativeResidual()
+{
+  Real res = 0.0;
+  if (solver_flag == 0 || solver_flag == 1) {
+    HYPRE_SStructSplitGetFinalRelativeResidualNorm(solver, &res);
+  }
+  else if (solver_flag == 2) {
+    HYPRE_SStructSysPFMGGetFinalRelativeResidualNorm(solver, &res);
+  }
+  return res;
+}
+
+Real HypreMGABec::getAbsoluteResidual()
+{
+  BL_PROFILE("HypreMGABec::getAbsoluteResidual");
+
+  Real bnorm;
+  hypre_SStructInnerProd((hypre_SStructVector *) b,
+                         (hypre_SStructVector *) b,
+                         &bnorm);
+  bnorm = sqrt(bnorm);
+
+  Real res = getRelativeResidual();
+
+  const BoxArray& grids = acoefs->boxArray();
+  Real volume = 0.0;
+  for (int i = 0; i < grids.size(); i++) {
+    volume += grids[i].numPts();
+  }
+  volume *= ngroups;
+
+  return bnorm * res / sqrt(volume);
+}
@@ -55,10 +55,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
       Er_lag.FillBoundary(parent->Geom(level).periodicity());
 
       MultiFab& S_lag = castro->get_old_data(State_Type);
-      for (FillPatchIterator fpi(*castro,S_lag,ngrow,oldtime,State_Type,
-				 0,S_lag.nComp()); fpi.isValid(); ++fpi) {
-	S_lag[fpi].copy(fpi());
-      }
+      castro->fill_patch_cached(S_lag, ngrow, oldtime, State_Type, 0, S_lag.nComp());
 
       MultiFab kpr_lag(grids,nGroups,1);
       MGFLD_compute_rosseland(kpr_lag, S_lag); 
@@ -338,44 +335,87 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
       compute_coupling(coupT, coupY, kappa_p, Er_pi, jg);
 
-      for (int igroup=0; igroup<nGroups; ++igroup) {
+      if (solver.haveBlockSolver()) {
 
-	set_current_group(igroup);
+	// The group equations are independent within an inner
+	// iteration, so set them all up and solve them together.
 
-	// setup and solve linear system
+	solver.levelBlockBndry(mgbd);
 
-	// set boundary condition
-	solver.levelBndry(mgbd, igroup);
-	
-	solver.levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+	solver.levelBlockACoeffs(level, kappa_p, delta_t, c, ptc_tau);
 
-	int lamcomp = (limiter==0) ? 0 : igroup;
-	solver.levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
+	solver.levelBlockBCoeffs(level, lambda, kappa_r, c);
 
 	if (have_Sanchez_Pomraning) {
-	  solver.levelSPas(level, lambda, igroup, lo_bc, hi_bc);
+	  solver.levelBlockSPas(level, lambda, lo_bc, hi_bc);
 	}
 
 	{ // src and rhd block
-	  	  
-	  MultiFab rhs(grids,1,0);
 
-	  solver.levelRhs(level, rhs, jg, mugT, mugY, 
-			  coupT, coupY, etaT, etaY, thetaT, thetaY,
-			  Er_step, rhoe_step, rhoYe_step, Er_star, rhoe_star, rhoYe_star, 
-			  delta_t, igroup, it, ptc_tau);
+	  MultiFab rhs(grids,nGroups,0);
+	  MultiFab rhs_g(grids,1,0);
+
+	  for (int igroup=0; igroup<nGroups; ++igroup) {
+	    solver.levelRhs(level, rhs_g, jg, mugT, mugY, 
+			    coupT, coupY, etaT, etaY, thetaT, thetaY,
+			    Er_step, rhoe_step, rhoYe_step, Er_star, rhoe_star, rhoYe_star, 
+			    delta_t, igroup, it, ptc_tau);
+	    MultiFab::Copy(rhs, rhs_g, 0, igroup, 1, 0);
+	  }
 
-	  // solve Er equation and put solution in Er_new(igroup)
-	  solver.levelSolve(level, Er_new, igroup, rhs, 0.01);
+	  // solve Er equations and put solution in Er_new
+	  solver.levelBlockSolve(level, Er_new, rhs, 0.01);
 	} // end src and rhs block
 
-	solver.levelFlux(level, Flux, Er_new, igroup);
-	solver.levelFluxReg(level, flux_in, flux_out, Flux, igroup);
-	  
-	if (icomp_flux >= 0) 
+	for (int igroup=0; igroup<nGroups; ++igroup) {
+	  solver.levelFlux(level, Flux, Er_new, igroup);
+	  solver.levelFluxReg(level, flux_in, flux_out, Flux, igroup);
+
+	  if (icomp_flux >= 0) 
 	    solver.levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
+	}
+
+      }
+      else {
+	for (int igroup=0; igroup<nGroups; ++igroup) {
+
+	  set_current_group(igroup);
 
-      } // end loop over groups
+	  // setup and solve linear system
+
+	  // set boundary condition
+	  solver.levelBndry(mgbd, igroup);
+	
+	  solver.levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+
+	  int lamcomp = (limiter==0) ? 0 : igroup;
+	  solver.levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
+
+	  if (have_Sanchez_Pomraning) {
+	    solver.levelSPas(level, lambda, igroup, lo_bc, hi_bc);
+	  }
+
+	  { // src and rhd block
+	  	  
+	    MultiFab rhs(grids,1,0);
+
+	    solver.levelRhs(level, rhs, jg, mugT, mugY, 
+			    coupT, coupY, etaT, etaY, thetaT, thetaY,
+			    Er_step, rhoe_step, rhoYe_step, Er_star, rhoe_star, rhoYe_star, 
+			    delta_t, igroup, it, ptc_tau);
+
+	    // solve Er equation and put solution in Er_new(igroup)
+	    solver.levelSolve(level, Er_new, igroup, rhs, 0.01);
+	  } // end src and rhs block
+
+	  solver.levelFlux(level, Flux, Er_new, igroup);
+	  solver.levelFluxReg(level, flux_in, flux_out, Flux, igroup);
+	  
+	  if (icomp_flux >= 0) 
+	      solver.levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
+
+	} // end loop over groups
+      }
       
       // Check for convergence *before* acceleration step:
       check_convergence_er(relative_in, absolute_in, error_er, Er_new, Er_pi,
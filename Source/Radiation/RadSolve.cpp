@@ -21,7 +21,7 @@
 Array<Real> RadSolve::absres(0);
 
 RadSolve::RadSolve(Amr* Parent) : parent(Parent),
-  hd(NULL), hm(NULL)
+  hd(NULL), hm(NULL), hg(NULL), hm_solver_built(false), hm_matrix_changed(true)
 {
   ParmParse pp("radsolve");
 
@@ -37,6 +37,22 @@ RadSolve::RadSolve(Amr* Parent) : parent(Parent),
   use_hypre_nonsymmetric_terms = 0;
   pp.query("use_hypre_nonsymmetric_terms", use_hypre_nonsymmetric_terms);
 
+  // Solve for all the groups of the MGFLD solver together
+  block_group_solve = 0;
+  pp.query("block_group_solve", block_group_solve);
+  if (Radiation::SolverType != Radiation::MGFLDSolver || Radiation::nGroups < 2) {
+    block_group_solve = 0;
+  }
+
+  if (BL_SPACEDIM == 1) {
+    // pfmg will not work in 1D
+    block_solver_flag = 0;
+  }
+  else {
+    block_solver_flag = 1;
+  }
+  pp.query("block_solver_flag", block_solver_flag);
+
   if (Radiation::SolverType == Radiation::SGFLDSolver 
       && Radiation::Er_Lorentz_term) { 
 
@@ -101,6 +117,10 @@ RadSolve::RadSolve(Amr* Parent) : parent(Parent),
     std::cout << "radsolve.abstol                 = " << abstol << std::endl;
     std::cout << "radsolve.use_hypre_nonsymmetric_terms = "
          << use_hypre_nonsymmetric_terms << std::endl;
+    std::cout << "radsolve.block_group_solve      = " << block_group_solve << std::endl;
+    if (block_group_solve) {
+      std::cout << "radsolve.block_solver_flag      = " << block_solver_flag << std::endl;
+    }
     std::cout << "radsolve.verbose                = " << verbose << std::endl;
   }
 
@@ -133,6 +153,13 @@ void RadSolve::levelInit(int level)
       hm->addLevel(level, parent->Geom(level), grids,
                    IntVect::TheUnitVector());
       hm->buildMatrixStructure();
+      hm_solver_built   = false;
+      hm_matrix_changed = true;
+  }
+
+  if (block_group_solve) {
+      hg = new HypreMGABec(grids, parent->Geom(level), Radiation::nGroups,
+			   block_solver_flag);
   }
 }
 
@@ -145,6 +172,7 @@ void RadSolve::levelBndry(RadBndry& bd)
   }
   else if (hm) {
     hm->setBndry(hm->crseLevel(), bd);
+    hm_matrix_changed = true;
   }
 }
 
@@ -158,6 +186,7 @@ void RadSolve::levelBndry(MGRadBndry& mgbd, const int comp)
   }
   else if (hm) {
     hm->setBndry(hm->crseLevel(), mgbd, comp);
+    hm_matrix_changed = true;
   }
 }
 
@@ -168,9 +197,17 @@ void RadSolve::levelClear()
     hd = NULL;
   }
   else if (hm) {
+    if (hm_solver_built) {
+      hm->clearSolver();
+      hm_solver_built = false;
+    }
     delete hm;
     hm = NULL;
   }
+  if (hg) {
+    delete hg;
+    hg = NULL;
+  }
 }
 
 void RadSolve::cellCenteredApplyMetrics(int level, MultiFab& cc)
@@ -204,6 +241,7 @@ void RadSolve::setLevelACoeffs(int level, const MultiFab& acoefs)
     }
     else if (hm) {
 	hm->aCoefficients(level, acoefs);
+	hm_matrix_changed = true;
     }
 }
 
@@ -214,6 +252,7 @@ void RadSolve::setLevelBCoeffs(int level, const MultiFab& bcoefs, int dir)
     }
     else if (hm) {
 	hm->bCoefficients(level, bcoefs, dir);
+	hm_matrix_changed = true;
     }
 }
 
@@ -223,6 +262,7 @@ void RadSolve::setLevelCCoeffs(int level, const MultiFab& ccoefs, int dir)
     HypreExtMultiABec *hem = dynamic_cast<HypreExtMultiABec*>(hm);
     if (hem) {
       hem->cCoefficients(level, ccoefs, dir);
+      hm_matrix_changed = true;
     }
   }
 }
@@ -264,6 +304,7 @@ void RadSolve::levelACoeffs(int level,
   }
   else if (hm) {
     hm->aCoefficients(level, acoefs);
+    hm_matrix_changed = true;
   }
 }
 
@@ -309,6 +350,7 @@ void RadSolve::levelSPas(int level, Tuple<MultiFab, BL_SPACEDIM>& lambda, int ig
 
   if (hm) {
     hm->SPalpha(level, spa);
+    hm_matrix_changed = true;
   }
   else if (hd) {
     hd->SPalpha(spa);
@@ -358,6 +400,7 @@ void RadSolve::levelBCoeffs(int level,
     }
     else if (hm) {
 	hm->bCoefficients(level, bcoefs, idim);
+	hm_matrix_changed = true;
     }
   } // -->> over dimension
 }
@@ -393,6 +436,7 @@ void RadSolve::levelDCoeffs(int level, Tuple<MultiFab, BL_SPACEDIM>& lambda,
 	HypreExtMultiABec *hem = (HypreExtMultiABec*)hm;
 	hem->d2Coefficients(level, dcoefs, idim);
 	hem->d2Multiplier() = 1.0;
+	hm_matrix_changed = true;
     }
 }
 
@@ -463,6 +507,9 @@ void RadSolve::levelSolve(int level,
     hm->setScalars(alpha, beta);
   }
 
+  // HypreABec keeps its solver setup between solves itself, and only
+  // redoes it when the matrix changes.
+
   if (hd) {
     hd->setupSolver(reltol, abstol, maxiter);
     hd->solve(Er, igroup, rhs, Inhomogeneous_BC);
@@ -474,14 +521,28 @@ void RadSolve::levelSolve(int level,
     }
     res *= sync_absres_factor;
     absres[level] = (absres[level] > res) ? absres[level] : res;
-    hd->clearSolver();
   }
   else if (hm) {
-    hm->loadMatrix();
-    hm->finalizeMatrix();
+    // Keep the matrix and solver setup of hm if nothing that goes into
+    // the matrix has changed, unless the solve may adjust the tolerance
+    // (abstol > 0), or FAC, whose setup also modifies the vectors.
+    bool reuse = hm_solver_built && !hm_matrix_changed &&
+                 abstol <= 0.0 && level_solver_flag != 101;
+    if (!reuse) {
+      if (hm_solver_built) {
+        hm->clearSolver();
+        hm_solver_built = false;
+      }
+      hm->loadMatrix();
+      hm->finalizeMatrix();
+    }
     hm->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
     hm->finalizeVectors();
-    hm->setupSolver(reltol, abstol, maxiter);
+    if (!reuse) {
+      hm->setupSolver(reltol, abstol, maxiter);
+      hm_solver_built   = true;
+      hm_matrix_changed = false;
+    }
     hm->solve();
     hm->getSolution(level, Er, igroup);
     Real res = hm->getAbsoluteResidual();
@@ -492,7 +553,6 @@ void RadSolve::levelSolve(int level,
     }
     res *= sync_absres_factor;
     absres[level] = (absres[level] > res) ? absres[level] : res;
-    hm->clearSolver();
   }
 }
 
@@ -551,7 +611,12 @@ void RadSolve::levelFlux(int level,
 #endif
   for (int n = 0; n < BL_SPACEDIM; n++) {
     const MultiFab *bp; //, *cp;
-    if (hd) {
+    int bcomp = 0;
+    if (hg) {
+      bp = &hg->bCoefficients(n);
+      bcomp = igroup;
+    }
+    else if (hd) {
       bp = &hd->bCoefficients(n);
     }
     else if (hm) {
@@ -571,7 +636,7 @@ void RadSolve::levelFlux(int level,
 	const Box& reg = fi.tilebox();
 	set_abec_flux(ARLIM(reg.loVect()), ARLIM(reg.hiVect()), &n,
 		      BL_TO_FORTRAN(Erborder[fi]), 
-		      BL_TO_FORTRAN(bcoef[fi]), 
+		      BL_TO_FORTRAN_N(bcoef[fi], bcomp), 
 		      &beta,
 		      dx,
 		      BL_TO_FORTRAN(Flux[n][fi]));
@@ -587,7 +652,10 @@ void RadSolve::levelFlux(int level,
   // by themselves, though, because the current implementation
   // trashes the boundary fluxes before fixing them.
 
-  if (hd) {
+  if (hg) {
+    hg->boundaryFlux(&Flux[0], Er, igroup, Inhomogeneous_BC);
+  }
+  else if (hd) {
     hd->boundaryFlux(&Flux[0], Er, igroup, Inhomogeneous_BC);
   }
   else if (hm) {
@@ -802,6 +870,7 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
   }
   else if (hm) {
     hm->aCoefficients(level,acoefs);
+    hm_matrix_changed = true;
   }
 }
 
@@ -887,6 +956,157 @@ void RadSolve::levelRhs(int level, MultiFab& rhs, const MultiFab& jg,
   }
 }
 
+void RadSolve::levelBlockBndry(MGRadBndry& mgbd)
+{
+  BL_ASSERT(hg);
+  hg->setBndry(mgbd);
+}
+
+void RadSolve::levelBlockACoeffs(int level, MultiFab& kpp,
+				 Real delta_t, Real c, Real ptc_tau)
+{
+  BL_PROFILE("RadSolve::levelBlockACoeffs (MGFLD)");
+  BL_ASSERT(hg);
+  const BoxArray& grids = parent->boxArray(level);
+  const int ngroups = hg->nGroups();
+
+  MultiFab acoefs(grids, ngroups, 0, Fab_allocate);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+      Array<Real> r, s;
+
+      for (MFIter mfi(kpp,true); mfi.isValid(); ++mfi) {
+	  const Box &reg = mfi.tilebox();
+
+	  getCellCenterMetric(parent->Geom(level), reg, r, s);
+
+	  Real dt_ptc = delta_t/(1.0+ptc_tau);
+	  for (int igroup = 0; igroup < ngroups; igroup++) {
+	      lacoefmgfld(BL_TO_FORTRAN_N(acoefs[mfi], igroup),
+			  ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+			  BL_TO_FORTRAN_N(kpp[mfi], igroup),
+			  r.dataPtr(), s.dataPtr(), dt_ptc, c);
+	  }
+      }
+  }
+
+  hg->aCoefficients(acoefs);
+}
+
+void RadSolve::levelBlockBCoeffs(int level,
+				 Tuple<MultiFab, BL_SPACEDIM>& lambda,
+				 MultiFab& kappa_r, Real c)
+{
+  BL_PROFILE("RadSolve::levelBlockBCoeffs (MGFLD)");
+  BL_ASSERT(hg);
+  BL_ASSERT(kappa_r.nGrow() == 1);
+
+  const Geometry& geom = parent->Geom(level);
+  const Real* dx       = geom.CellSize();
+  const int ngroups    = hg->nGroups();
+
+  for (int idim = 0; idim < BL_SPACEDIM; idim++) {
+
+    MultiFab bcoefs(lambda[idim].boxArray(), ngroups, 0, Fab_allocate);
+
+    // lambda has one component per group unless there is no limiter
+    const int lamstride = (lambda[idim].nComp() == 1) ? 0 : 1;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+	Array<Real> r, s;
+
+	for (MFIter mfi(lambda[idim],true); mfi.isValid(); ++mfi) {
+	    const Box &ndbox  = mfi.tilebox();
+	    getEdgeMetric(idim, geom, ndbox, r, s);
+
+	    const Box& reg = BoxLib::enclosedCells(ndbox);
+	    for (int igroup = 0; igroup < ngroups; igroup++) {
+		bclim(bcoefs[mfi].dataPtr(igroup),
+		      BL_TO_FORTRAN_N(lambda[idim][mfi], lamstride*igroup),
+		      ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
+		      idim,
+		      BL_TO_FORTRAN_N(kappa_r[mfi], igroup),
+		      r.dataPtr(), s.dataPtr(), c, dx);
+	    }
+	}
+    }
+
+    hg->bCoefficients(bcoefs, idim);
+  }
+}
+
+void RadSolve::levelBlockSPas(int level, Tuple<MultiFab, BL_SPACEDIM>& lambda,
+			      int lo_bc[3], int hi_bc[3])
+{
+  BL_ASSERT(hg);
+  const BoxArray& grids = parent->boxArray(level);
+  const Geometry& geom = parent->Geom(level);
+  const Box& domainBox = geom.Domain();
+  const int ngroups = hg->nGroups();
+
+  MultiFab spa(grids, ngroups, 0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(spa,true); mfi.isValid(); ++mfi) {
+      const Box& reg  = mfi.tilebox();
+
+      spa[mfi].setVal(1.e210,reg,0,ngroups);
+
+      bool nexttoboundary=false;
+      for (int idim=0; idim<BL_SPACEDIM; idim++) {
+	  if (lo_bc[idim] == LO_SANCHEZ_POMRANING &&
+	      reg.smallEnd(idim) == domainBox.smallEnd(idim)) {
+	      nexttoboundary=true;
+	      break;
+	  }
+	  if (hi_bc[idim] == LO_SANCHEZ_POMRANING &&
+	      reg.bigEnd(idim) == domainBox.bigEnd(idim)) {
+	      nexttoboundary=true;
+	      break;
+	  }
+      }
+
+      if (nexttoboundary) {
+	  for (int igroup = 0; igroup < ngroups; igroup++) {
+	      ca_spalpha(reg.loVect(), reg.hiVect(),
+			 BL_TO_FORTRAN_N(spa[mfi], igroup),
+			 D_DECL(BL_TO_FORTRAN(lambda[0][mfi]),
+				BL_TO_FORTRAN(lambda[1][mfi]),
+				BL_TO_FORTRAN(lambda[2][mfi])),
+			 &igroup);
+	  }
+      }
+  }
+
+  hg->SPalpha(spa);
+}
+
+void RadSolve::levelBlockSolve(int level, MultiFab& Er, MultiFab& rhs,
+			       Real sync_absres_factor)
+{
+  BL_PROFILE("RadSolve::levelBlockSolve");
+  BL_ASSERT(hg);
+
+  hg->setScalars(alpha, beta);
+  hg->setupSolver(reltol, abstol, maxiter);
+  hg->solve(Er, rhs, Inhomogeneous_BC);
+  Real res = hg->getAbsoluteResidual();
+  if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+    int oldprec = std::cout.precision(20);
+    std::cout << "Absolute residual = " << res << std::endl;
+    std::cout.precision(oldprec);
+  }
+  res *= sync_absres_factor;
+  absres[level] = (absres[level] > res) ? absres[level] : res;
+}
+
 // </ MGFLD routines>
 
 void RadSolve::setHypreMulti(Real cMul, Real d1Mul, Real d2Mul)
@@ -896,6 +1116,7 @@ void RadSolve::setHypreMulti(Real cMul, Real d1Mul, Real d2Mul)
     hem-> cMultiplier() =  cMul;
     hem->d1Multiplier() = d1Mul;
     hem->d2Multiplier() = d2Mul;
+    hm_matrix_changed = true;
   }
 }
 
@@ -906,6 +1127,7 @@ void RadSolve::restoreHypreMulti()
     hem-> cMultiplier() =  cMulti;
     hem->d1Multiplier() = d1Multi;
     hem->d2Multiplier() = d2Multi;  
+    hm_matrix_changed = true;
   }
 }
 
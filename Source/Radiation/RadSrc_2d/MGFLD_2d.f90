@@ -358,6 +358,7 @@ subroutine ca_compute_emissivity( lo, hi, &
   use rad_params_module, only : ngroups, nugroup, dnugroup, xnu,  &
        pi, clight, hplanck, kboltz, arad
   use blackbody_module, only : BdBdTIndefInteg
+  use planck_table_module, only : use_planck_table, planck_table_lookup
 
   use bl_fort_module, only : rt => c_real
   implicit none
@@ -384,6 +385,7 @@ subroutine ca_compute_emissivity( lo, hi, &
   real(rt)         :: B0, B1, dBdT0, dBdT1
   real(rt)         :: dnu, nubar, expnubar, cdBdT
   real(rt)         :: xnu_full(0:ngroups)
+  real(rt)         :: Bgv(0:ngroups-1), dBdTv(0:ngroups-1)
 
   if (ngroups .eq. 1) then
 
@@ -432,6 +434,19 @@ subroutine ca_compute_emissivity( lo, hi, &
         end do
      end do
 
+  else if (integrate_Planck > 0 .and. use_planck_table) then
+
+     do j=lo(2), hi(2)
+     do i=lo(1), hi(1)
+        Teff = max(T(i,j), 1.e-50_rt)
+        call planck_table_lookup(Teff, Bgv, dBdTv)
+        do g=0, ngroups-1
+           jg(i,j,g) = Bgv(g)*kap(i,j,g)
+           djdT(i,j,g) = dkdT(i,j,g)*Bgv(g) + dBdTv(g)*kap(i,j,g)
+        end do
+     end do
+     end do
+
   else if (integrate_Planck > 0) then
 
      xnu_full = xnu(0:ngroups)
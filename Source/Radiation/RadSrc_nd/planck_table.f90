@@ -0,0 +1,149 @@
+! Table of the group-integrated Planck function and its temperature
+! derivative, built once at startup.  The MGFLD emissivity needs B_g(T)
+! and dB_g/dT for every group in every cell, at every outer iteration.
+! Integrating the Planck function directly costs an exponential and a
+! series evaluation per group boundary; with the table it is a single
+! log and a cubic interpolation per group.
+!
+! The table stores the fraction F_g = B_g / (a T^4) and its derivative
+! with respect to log(T) on a uniform grid in log(T), and uses cubic
+! Hermite interpolation.  The derivative returned is the derivative of
+! the interpolant, so that B_g and dB_g/dT stay consistent for the
+! Newton iteration.  Temperatures outside the table fall back to the
+! direct integration.
+
+module planck_table_module
+
+  use bl_fort_module, only : rt => c_real
+  implicit none
+
+  logical, save :: use_planck_table = .false.
+
+  integer, save :: ntemp
+  real(rt)        , save :: logT_min, logT_max, dlogT, dlogT_inv
+  real(rt)        , save, allocatable :: Ftab(:,:), Dtab(:,:)
+
+  private
+  public :: use_planck_table, ca_init_planck_table, &
+       planck_table_lookup, group_planck_integ
+
+contains
+
+  subroutine ca_init_planck_table(Tmin, Tmax, npts_per_decade) &
+       bind(C, name="ca_init_planck_table")
+
+    use rad_params_module, only : ngroups
+    use fundamental_constants_module, only : a_rad
+
+    use bl_fort_module, only : rt => c_real
+    real(rt)        , intent(in) :: Tmin, Tmax
+    integer, intent(in) :: npts_per_decade
+
+    integer :: n
+    real(rt)         :: T, Bg(0:ngroups-1), dBdT(0:ngroups-1)
+
+    if (allocated(Ftab)) deallocate(Ftab)
+    if (allocated(Dtab)) deallocate(Dtab)
+
+    logT_min = log(Tmin)
+    logT_max = log(Tmax)
+    ntemp = max(int(npts_per_decade * log10(Tmax/Tmin)), 1) + 1
+    dlogT = (logT_max - logT_min) / (ntemp-1)
+    dlogT_inv = 1.e0_rt / dlogT
+
+    allocate(Ftab(0:ngroups-1,0:ntemp-1))
+    allocate(Dtab(0:ngroups-1,0:ntemp-1))
+
+    do n = 0, ntemp-1
+       T = exp(logT_min + n*dlogT)
+       call group_planck_integ(T, Bg, dBdT)
+       ! d F / d log(T) = T dB/dT / (a T^4) - 4 F
+       Ftab(:,n) = Bg / (a_rad*T**4)
+       Dtab(:,n) = dBdT / (a_rad*T**3) - 4.e0_rt*Ftab(:,n)
+    end do
+
+    use_planck_table = .true.
+
+  end subroutine ca_init_planck_table
+
+
+  ! Group-integrated Planck function for all groups.  The lower bound of
+  ! the first group is 0 and the upper bound of the last group is infinity.
+  subroutine group_planck_integ(T, Bg, dBdT)
+
+    use rad_params_module, only : ngroups, xnu
+    use blackbody_module, only : BdBdTIndefInteg
+
+    use bl_fort_module, only : rt => c_real
+    real(rt)        , intent(in) :: T
+    real(rt)        , intent(out) :: Bg(0:ngroups-1), dBdT(0:ngroups-1)
+
+    integer :: g
+    real(rt)         :: B0, B1, dBdT0, dBdT1, nu1
+
+    call BdBdTIndefInteg(T, 0.e0_rt, B1, dBdT1)
+    do g = 0, ngroups-1
+       B0 = B1
+       dBdT0 = dBdT1
+       if (g .eq. ngroups-1) then
+          nu1 = max(xnu(ngroups), 1.e25_rt)
+       else
+          nu1 = xnu(g+1)
+       end if
+       call BdBdTIndefInteg(T, nu1, B1, dBdT1)
+       Bg(g) = B1 - B0
+       dBdT(g) = dBdT1 - dBdT0
+    end do
+
+  end subroutine group_planck_integ
+
+
+  subroutine planck_table_lookup(T, Bg, dBdT)
+
+    use rad_params_module, only : ngroups
+    use fundamental_constants_module, only : a_rad
+
+    use bl_fort_module, only : rt => c_real
+    real(rt)        , intent(in) :: T
+    real(rt)        , intent(out) :: Bg(0:ngroups-1), dBdT(0:ngroups-1)
+
+    integer :: n, g
+    real(rt)         :: logT, t1, t2, t3, aT3, aT4, h
+    real(rt)         :: h00, h10, h01, h11, d00, d10, d01, d11, F, dFdlogT
+
+    logT = log(T)
+
+    if (logT < logT_min .or. logT >= logT_max) then
+       call group_planck_integ(T, Bg, dBdT)
+       return
+    end if
+
+    t1 = (logT - logT_min) * dlogT_inv
+    n = min(int(t1), ntemp-2)
+    t1 = t1 - n
+    t2 = t1*t1
+    t3 = t2*t1
+
+    h = dlogT
+    h00 =  2.e0_rt*t3 - 3.e0_rt*t2 + 1.e0_rt
+    h10 = (t3 - 2.e0_rt*t2 + t1) * h
+    h01 = -2.e0_rt*t3 + 3.e0_rt*t2
+    h11 = (t3 - t2) * h
+    d00 = ( 6.e0_rt*t2 - 6.e0_rt*t1) * dlogT_inv
+    d10 =   3.e0_rt*t2 - 4.e0_rt*t1 + 1.e0_rt
+    d01 = (-6.e0_rt*t2 + 6.e0_rt*t1) * dlogT_inv
+    d11 =   3.e0_rt*t2 - 2.e0_rt*t1
+
+    aT3 = a_rad*T**3
+    aT4 = aT3*T
+
+    do g = 0, ngroups-1
+       F = h00*Ftab(g,n) + h10*Dtab(g,n) + h01*Ftab(g,n+1) + h11*Dtab(g,n+1)
+       dFdlogT = d00*Ftab(g,n) + d10*Dtab(g,n) + d01*Ftab(g,n+1) + d11*Dtab(g,n+1)
+       Bg(g) = aT4 * F
+       dBdT(g) = aT3 * (4.e0_rt*F + dFdlogT)
+    end do
+
+  end subroutine planck_table_lookup
+
+end module planck_table_module
@@ -550,6 +550,15 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
   integrate_Planck = 1;
   pp.query("integrate_Planck", integrate_Planck);
 
+  use_Planck_table = 0;
+  pp.query("use_Planck_table", use_Planck_table);
+  Planck_table_Tmin = 1.0;
+  pp.query("Planck_table_Tmin", Planck_table_Tmin);
+  Planck_table_Tmax = 1.e10;
+  pp.query("Planck_table_Tmax", Planck_table_Tmax);
+  Planck_table_npts = 100;
+  pp.query("Planck_table_npts", Planck_table_npts);
+
   use_WiensLaw = 0;
   pp.query("use_WiensLaw", use_WiensLaw);
   Tf_Wien = -1.0;
@@ -712,6 +721,14 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
 
     get_groups(verbose);
 
+    if (SolverType == MGFLDSolver && radiation_type == Photon &&
+	integrate_Planck > 0 && use_WiensLaw == 0 && use_Planck_table > 0) {
+      if (verbose >= 1 && ParallelDescriptor::IOProcessor()) {
+	std::cout << "building table of group-integrated Planck functions..." << std::endl;
+      }
+      ca_init_planck_table(Planck_table_Tmin, Planck_table_Tmax, Planck_table_npts);
+    }
+
 #ifdef NEUTRINO
     if (SolverType == MGFLDSolver && radiation_type == Neutrino) {
       // load opacities from (Burrows) table
@@ -69,13 +69,12 @@ contains
 
 
   subroutine ca_compute_radial_mass (lo,hi,dx,dr,&
-                                     state,r_l1,r_h1, &
+                                     rho,r_l1,r_h1, &
                                      radial_mass,radial_vol,problo, &
                                      n1d,drdxfac,level) bind(C, name="ca_compute_radial_mass")
 
     use bl_constants_module, only: HALF, FOUR3RD, M_PI
     use prob_params_module, only: center, Symmetry, physbc_lo, coord_type
-    use meth_params_module, only: NVAR, URHO
 
     use bl_fort_module, only : rt => c_real
     implicit none
@@ -89,7 +88,7 @@ contains
     real(rt)         :: radial_vol (0:n1d-1)
 
     integer          :: r_l1, r_h1
-    real(rt)         :: state(r_l1:r_h1,NVAR)
+    real(rt)         :: rho(r_l1:r_h1)
 
     integer          :: i, index
     integer          :: ii
@@ -143,7 +142,7 @@ contains
              index = int(r / dr)
 
              if (index .le. n1d-1) then
-                radial_mass(index) = radial_mass(index) + vol * state(i,URHO)
+                radial_mass(index) = radial_mass(index) + vol * rho(i)
                 radial_vol (index) = radial_vol (index) + vol
              end if
 
@@ -71,6 +71,50 @@ contains
 
 
 
+  subroutine ca_apply_metric_rhs(lo, hi, &
+       rhs, rl1, rh1, dx, coord_type) bind(C, name="ca_apply_metric_rhs")
+
+    ! The cell-centered part of ca_apply_metric, for when the
+    ! edge coefficients have already been weighted.
+
+    use bl_fort_module, only : rt => c_real
+    implicit none
+    
+    integer lo(1),hi(1)
+    integer rl1, rh1
+    integer coord_type
+    real(rt)         rhs(rl1:rh1)
+    real(rt)         dx(1)
+
+    real(rt)         r,rlo,rhi
+    integer i
+
+    ! r-z
+    if (coord_type .eq. 1) then
+
+       do i=lo(1),hi(1)
+          r = (dble(i)+0.5e0_rt) * dx(1)
+          rhs(i) = rhs(i) * r
+       enddo
+
+       ! spherical
+    else if (coord_type .eq. 2) then
+
+       do i=lo(1),hi(1)
+          rlo = dble(i) * dx(1)
+          rhi = rlo + dx(1)
+          rhs(i) = rhs(i) * (rhi**3 - rlo**3) / (3.e0_rt * dx(1))
+       enddo
+
+    else 
+       print *,'Bogus coord_type in apply_metric_rhs ' ,coord_type
+       call bl_error("Error:: MGutils_1d.f90 :: ca_apply_metric_rhs")
+    end if
+
+  end subroutine ca_apply_metric_rhs
+
+
+
   subroutine ca_weight_cc(lo, hi, &
        cc, cl1, ch1,  &
        dx, coord_type) bind(C, name="ca_weight_cc")
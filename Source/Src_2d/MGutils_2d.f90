@@ -67,6 +67,44 @@ contains
 
 
 
+  subroutine ca_apply_metric_rhs(lo, hi, &
+       rhs, rl1, rl2, rh1, rh2, dx, coord_type) &
+       bind(C, name="ca_apply_metric_rhs")
+
+    ! The cell-centered part of ca_apply_metric, for when the
+    ! edge coefficients have already been weighted.
+
+    use bl_fort_module, only : rt => c_real
+    implicit none
+    
+    integer lo(2),hi(2)
+    integer rl1, rl2, rh1, rh2
+    integer coord_type
+    real(rt)         rhs(rl1:rh1,rl2:rh2)
+    real(rt)         dx(2)
+
+    real(rt)         r
+    integer i,j
+
+    ! r-z
+    if (coord_type .eq. 1) then
+
+       do i=lo(1),hi(1)
+          r = (dble(i)+0.5e0_rt) * dx(1)
+          do j=lo(2),hi(2)
+             rhs(i,j) = rhs(i,j) * r
+          enddo
+       enddo
+
+    else 
+       print *,'Bogus coord_type in apply_metric_rhs ' ,coord_type
+       call bl_error("Error:: MGutils_2d.f90 :: ca_apply_metric_rhs")
+    end if
+
+  end subroutine ca_apply_metric_rhs
+
+
+
   subroutine ca_weight_cc(lo, hi, &
        cc, cl1, cl2, ch1, ch2,  &
        dx, coord_type) bind(C, name="ca_weight_cc")
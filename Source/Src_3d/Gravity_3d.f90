@@ -49,13 +49,12 @@ contains
 
 
   subroutine ca_compute_radial_mass (lo,hi,dx,dr,&
-       state,r_l1,r_l2,r_l3,r_h1,r_h2,r_h3,&
+       rho,r_l1,r_l2,r_l3,r_h1,r_h2,r_h3,&
        radial_mass,radial_vol,problo,&
        n1d,drdxfac,level) bind(C, name="ca_compute_radial_mass")
 
     use bl_constants_module
     use prob_params_module, only: center
-    use meth_params_module, only: NVAR, URHO
 
     use bl_fort_module, only : rt => c_real
     implicit none
@@ -69,7 +68,7 @@ contains
     real(rt)         :: radial_vol (0:n1d-1)
 
     integer          :: r_l1,r_l2,r_l3,r_h1,r_h2,r_h3
-    real(rt)         :: state(r_l1:r_h1,r_l2:r_h2,r_l3:r_h3,NVAR)
+    real(rt)         :: rho(r_l1:r_h1,r_l2:r_h2,r_l3:r_h3)
 
     integer          :: i,j,k,index
     integer          :: ii,jj,kk
@@ -136,7 +135,7 @@ contains
                          index = int(r*drinv)
 
                          if (index .le. n1d-1) then
-                            radial_mass(index) = radial_mass(index) + vol_frac * state(i,j,k,URHO)
+                            radial_mass(index) = radial_mass(index) + vol_frac * rho(i,j,k)
                             radial_vol (index) = radial_vol (index) + vol_frac
                          end if
                       end do
@@ -447,7 +446,7 @@ contains
                    if (l .eq. bclo(1)) then
                       locb(1) = problo(1)
                    else if (l .eq. bchi(1)) then
-                      locb(1) = probhi(2)
+                      locb(1) = probhi(1)
                    else
                       locb(1) = problo(1) + (dble(l)+HALF) * bcdx(1)
                    endif
@@ -616,6 +615,435 @@ contains
 
 
 
+  ! This computes the same boundary values as ca_compute_direct_sum_bc,
+  ! but with a Barnes-Hut tree over the zones in lo:hi.  The box is split
+  ! recursively in half in each direction down to leaf_size zones, and each
+  ! node stores the monopole, dipole and quadrupole moments of its mass about
+  ! its center. A node whose width is less than theta times its distance
+  ! to a boundary point is evaluated with its moments; otherwise we descend
+  ! into its children, and leaves are summed zone by zone. The mass hidden
+  ! behind symmetric boundaries is accounted for by evaluating the tree at
+  ! the mirror images of the boundary point.
+
+  subroutine ca_compute_direct_sum_bc_tree (lo, hi, dx, &
+                                            symmetry_type, lo_bc, hi_bc, &
+                                            rho, r_lo, r_hi, &
+                                            vol, v_lo, v_hi, &
+                                            problo, probhi, &
+                                            bcXYLo, bcXYHi, &
+                                            bcXZLo, bcXZHi, &
+                                            bcYZLo, bcYZHi, &
+                                            bclo, bchi, bcdx, theta) bind(C, name="ca_compute_direct_sum_bc_tree")
+
+    use fundamental_constants_module, only: Gconst
+    use bl_constants_module
+
+    use bl_fort_module, only : rt => c_real
+    implicit none
+
+    integer          :: lo(3), hi(3)
+    integer          :: bclo(3), bchi(3)
+    integer          :: r_lo(3), r_hi(3)
+    integer          :: v_lo(3), v_hi(3)
+    real(rt)         :: dx(3), bcdx(3)
+    real(rt)         :: problo(3), probhi(3)
+    real(rt)         :: theta
+
+    integer          :: symmetry_type
+    integer          :: lo_bc(3), hi_bc(3)
+
+    real(rt)         :: bcXYLo(bclo(1):bchi(1),bclo(2):bchi(2))
+    real(rt)         :: bcXYHi(bclo(1):bchi(1),bclo(2):bchi(2))
+    real(rt)         :: bcXZLo(bclo(1):bchi(1),bclo(3):bchi(3))
+    real(rt)         :: bcXZHi(bclo(1):bchi(1),bclo(3):bchi(3))
+    real(rt)         :: bcYZLo(bclo(2):bchi(2),bclo(3):bchi(3))
+    real(rt)         :: bcYZHi(bclo(2):bchi(2),bclo(3):bchi(3))
+
+    real(rt)         :: rho(r_lo(1):r_hi(1),r_lo(2):r_hi(2),r_lo(3):r_hi(3))
+    real(rt)         :: vol(v_lo(1):v_hi(1),v_lo(2):v_hi(2),v_lo(3):v_hi(3))
+
+    integer, parameter :: leaf_size = 8
+
+    ! The tree. For each node: its zones, its children, its signed mass,
+    ! the mass of its zones in absolute value (which sets the expansion
+    ! center, so that it is well defined for any sign of the source),
+    ! the expansion center, the dipole and quadrupole (xx, yy, zz, xy, xz, yz)
+    ! moments about it, and its largest side.
+
+    integer          :: nnodes, root
+    integer,  allocatable :: node_lo(:,:), node_hi(:,:), node_child(:,:), node_nchild(:)
+    real(rt), allocatable :: node_m(:), node_am(:), node_c(:,:), node_d(:,:), node_q(:,:), node_w(:)
+    integer,  allocatable :: stack(:)
+
+    ! The mirror images of a boundary point: for each direction, 0 to leave
+    ! it alone, -1 (1) to reflect it about the lo (hi) domain boundary.
+
+    integer          :: nimg, img(3,15)
+
+    integer          :: l, m, n, b, nzones
+    real(rt)         :: locb(3)
+
+    nzones = (hi(1)-lo(1)+1) * (hi(2)-lo(2)+1) * (hi(3)-lo(3)+1)
+
+    allocate(node_lo(3,2*nzones), node_hi(3,2*nzones))
+    allocate(node_child(8,2*nzones), node_nchild(2*nzones))
+    allocate(node_m(2*nzones), node_am(2*nzones), node_w(2*nzones))
+    allocate(node_c(3,2*nzones), node_d(3,2*nzones), node_q(6,2*nzones))
+    allocate(stack(2*nzones))
+
+    nnodes = 0
+    call build_node(lo, hi, root)
+
+    ! The images, in the same combinations as direct_sum_symmetric_add.
+
+    nimg = 1
+    img(:,1) = 0
+
+    do b = -1, 1, 2
+       if ( sym(1,b) ) then
+          call add_image(b, 0, 0)
+          if ( sym(2,b) ) call add_image(b, b, 0)
+          if ( sym(3,b) ) call add_image(b, 0, b)
+          if ( sym(2,b) .and. sym(3,b) ) call add_image(b, b, b)
+       endif
+       if ( sym(2,b) ) then
+          call add_image(0, b, 0)
+          if ( sym(3,b) ) call add_image(0, b, b)
+       endif
+       if ( sym(3,b) ) call add_image(0, 0, b)
+    enddo
+
+    ! Do xy interfaces first, then xz, then yz. As in ca_compute_direct_sum_bc,
+    ! the boundary values live on the interfaces, and we assume that
+    ! bclo = domlo - 1 and bchi = domhi + 1.
+
+    do m = bclo(2), bchi(2)
+       locb(2) = bc_loc(m, 2)
+       do l = bclo(1), bchi(1)
+          locb(1) = bc_loc(l, 1)
+
+          locb(3) = problo(3)
+          bcXYLo(l,m) = bcXYLo(l,m) + tree_phi_images(locb)
+
+          locb(3) = probhi(3)
+          bcXYHi(l,m) = bcXYHi(l,m) + tree_phi_images(locb)
+       enddo
+    enddo
+
+    do n = bclo(3), bchi(3)
+       locb(3) = bc_loc(n, 3)
+       do l = bclo(1), bchi(1)
+          locb(1) = bc_loc(l, 1)
+
+          locb(2) = problo(2)
+          bcXZLo(l,n) = bcXZLo(l,n) + tree_phi_images(locb)
+
+          locb(2) = probhi(2)
+          bcXZHi(l,n) = bcXZHi(l,n) + tree_phi_images(locb)
+       enddo
+    enddo
+
+    do n = bclo(3), bchi(3)
+       locb(3) = bc_loc(n, 3)
+       do m = bclo(2), bchi(2)
+          locb(2) = bc_loc(m, 2)
+
+          locb(1) = problo(1)
+          bcYZLo(m,n) = bcYZLo(m,n) + tree_phi_images(locb)
+
+          locb(1) = probhi(1)
+          bcYZHi(m,n) = bcYZHi(m,n) + tree_phi_images(locb)
+       enddo
+    enddo
+
+    deallocate(node_lo, node_hi, node_child, node_nchild)
+    deallocate(node_m, node_am, node_w, node_c, node_d, node_q)
+    deallocate(stack)
+
+  contains
+
+    logical function sym(dir, side)
+
+      integer, intent(in) :: dir, side
+
+      if (side < 0) then
+         sym = lo_bc(dir) .eq. symmetry_type
+      else
+         sym = hi_bc(dir) .eq. symmetry_type
+      endif
+
+    end function sym
+
+
+
+    subroutine add_image(ix, iy, iz)
+
+      integer, intent(in) :: ix, iy, iz
+
+      nimg = nimg + 1
+      img(:,nimg) = [ix, iy, iz]
+
+    end subroutine add_image
+
+
+
+    real(rt) function bc_loc(idx, dir)
+
+      integer, intent(in) :: idx, dir
+
+      if (idx .eq. bclo(dir)) then
+         bc_loc = problo(dir)
+      else if (idx .eq. bchi(dir)) then
+         bc_loc = probhi(dir)
+      else
+         bc_loc = problo(dir) + (dble(idx)+HALF) * bcdx(dir)
+      endif
+
+    end function bc_loc
+
+
+
+    real(rt) function tree_phi_images(pt)
+
+      real(rt), intent(in) :: pt(3)
+
+      integer  :: s, d
+      real(rt) :: pti(3)
+
+      tree_phi_images = ZERO
+
+      do s = 1, nimg
+         do d = 1, 3
+            if (img(d,s) < 0) then
+               pti(d) = TWO * problo(d) - pt(d)
+            else if (img(d,s) > 0) then
+               pti(d) = TWO * probhi(d) - pt(d)
+            else
+               pti(d) = pt(d)
+            endif
+         enddo
+         tree_phi_images = tree_phi_images + tree_phi(pti)
+      enddo
+
+    end function tree_phi_images
+
+
+
+    real(rt) function tree_phi(pt)
+
+      real(rt), intent(in) :: pt(3)
+
+      integer  :: nstack, id, ch, i, j, k
+      real(rt) :: R(3), r2, rinv, r3inv, r5inv, loc(3)
+
+      tree_phi = ZERO
+
+      nstack = 1
+      stack(1) = root
+
+      do while (nstack > 0)
+
+         id = stack(nstack)
+         nstack = nstack - 1
+
+         if (node_am(id) == ZERO) cycle
+
+         R = pt - node_c(:,id)
+         r2 = R(1)**2 + R(2)**2 + R(3)**2
+
+         if (node_w(id)**2 < theta**2 * r2) then
+
+            rinv  = ONE / sqrt(r2)
+            r3inv = rinv**3
+            r5inv = r3inv * rinv**2
+
+            tree_phi = tree_phi - Gconst * ( node_m(id) * rinv + &
+                 (node_d(1,id) * R(1) + node_d(2,id) * R(2) + node_d(3,id) * R(3)) * r3inv + &
+                 HALF * ( node_q(1,id) * R(1)**2 + node_q(2,id) * R(2)**2 + node_q(3,id) * R(3)**2 + &
+                          TWO * (node_q(4,id) * R(1) * R(2) + node_q(5,id) * R(1) * R(3) + &
+                                 node_q(6,id) * R(2) * R(3)) ) * r5inv )
+
+         else if (node_nchild(id) == 0) then
+
+            do k = node_lo(3,id), node_hi(3,id)
+               loc(3) = problo(3) + (dble(k)+HALF) * dx(3)
+               do j = node_lo(2,id), node_hi(2,id)
+                  loc(2) = problo(2) + (dble(j)+HALF) * dx(2)
+                  do i = node_lo(1,id), node_hi(1,id)
+                     loc(1) = problo(1) + (dble(i)+HALF) * dx(1)
+
+                     tree_phi = tree_phi - Gconst * rho(i,j,k) * vol(i,j,k) / &
+                          sqrt( (loc(1) - pt(1))**2 + (loc(2) - pt(2))**2 + (loc(3) - pt(3))**2 )
+                  enddo
+               enddo
+            enddo
+
+         else
+
+            do ch = 1, node_nchild(id)
+               nstack = nstack + 1
+               stack(nstack) = node_child(ch,id)
+            enddo
+
+         endif
+
+      enddo
+
+    end function tree_phi
+
+
+
+    recursive subroutine build_node(blo, bhi, id)
+
+      integer, intent(in)  :: blo(3), bhi(3)
+      integer, intent(out) :: id
+
+      integer  :: i, j, k, d, ch, cid, nch
+      integer  :: clo(3,8), chi(3,8), mid(3), nsplit(3), ix, iy, iz
+      real(rt) :: loc(3), dm, e(3), s(3), e2, s2, ds
+
+      nnodes = nnodes + 1
+      id = nnodes
+
+      node_lo(:,id) = blo
+      node_hi(:,id) = bhi
+      node_nchild(id) = 0
+
+      node_w(id) = maxval( dble(bhi - blo + 1) * dx )
+
+      node_m(id) = ZERO
+      node_am(id) = ZERO
+      node_c(:,id) = ZERO
+      node_d(:,id) = ZERO
+      node_q(:,id) = ZERO
+
+      if ( product(bhi - blo + 1) <= leaf_size ) then
+
+         ! Moments of the zones themselves.
+
+         do k = blo(3), bhi(3)
+            loc(3) = problo(3) + (dble(k)+HALF) * dx(3)
+            do j = blo(2), bhi(2)
+               loc(2) = problo(2) + (dble(j)+HALF) * dx(2)
+               do i = blo(1), bhi(1)
+                  loc(1) = problo(1) + (dble(i)+HALF) * dx(1)
+                  dm = rho(i,j,k) * vol(i,j,k)
+                  node_m(id) = node_m(id) + dm
+                  node_am(id) = node_am(id) + abs(dm)
+                  node_c(:,id) = node_c(:,id) + abs(dm) * loc
+               enddo
+            enddo
+         enddo
+
+         if (node_am(id) == ZERO) return
+
+         node_c(:,id) = node_c(:,id) / node_am(id)
+
+         do k = blo(3), bhi(3)
+            loc(3) = problo(3) + (dble(k)+HALF) * dx(3)
+            do j = blo(2), bhi(2)
+               loc(2) = problo(2) + (dble(j)+HALF) * dx(2)
+               do i = blo(1), bhi(1)
+                  loc(1) = problo(1) + (dble(i)+HALF) * dx(1)
+                  dm = rho(i,j,k) * vol(i,j,k)
+                  e = loc - node_c(:,id)
+                  e2 = e(1)**2 + e(2)**2 + e(3)**2
+                  node_d(:,id) = node_d(:,id) + dm * e
+                  node_q(1,id) = node_q(1,id) + dm * (THREE * e(1) * e(1) - e2)
+                  node_q(2,id) = node_q(2,id) + dm * (THREE * e(2) * e(2) - e2)
+                  node_q(3,id) = node_q(3,id) + dm * (THREE * e(3) * e(3) - e2)
+                  node_q(4,id) = node_q(4,id) + dm * THREE * e(1) * e(2)
+                  node_q(5,id) = node_q(5,id) + dm * THREE * e(1) * e(3)
+                  node_q(6,id) = node_q(6,id) + dm * THREE * e(2) * e(3)
+               enddo
+            enddo
+         enddo
+
+         return
+
+      endif
+
+      ! Split in half in every direction that is more than one zone wide.
+
+      do d = 1, 3
+         if (bhi(d) > blo(d)) then
+            nsplit(d) = 2
+            mid(d) = (blo(d) + bhi(d)) / 2
+         else
+            nsplit(d) = 1
+            mid(d) = bhi(d)
+         endif
+      enddo
+
+      nch = 0
+      do iz = 1, nsplit(3)
+         do iy = 1, nsplit(2)
+            do ix = 1, nsplit(1)
+               nch = nch + 1
+               clo(:,nch) = blo
+               chi(:,nch) = mid
+               if (ix == 2) then
+                  clo(1,nch) = mid(1) + 1
+                  chi(1,nch) = bhi(1)
+               endif
+               if (iy == 2) then
+                  clo(2,nch) = mid(2) + 1
+                  chi(2,nch) = bhi(2)
+               endif
+               if (iz == 2) then
+                  clo(3,nch) = mid(3) + 1
+                  chi(3,nch) = bhi(3)
+               endif
+            enddo
+         enddo
+      enddo
+
+      node_nchild(id) = nch
+
+      do ch = 1, nch
+         call build_node(clo(:,ch), chi(:,ch), cid)
+         node_child(ch,id) = cid
+         node_m(id) = node_m(id) + node_m(cid)
+         node_am(id) = node_am(id) + node_am(cid)
+         node_c(:,id) = node_c(:,id) + node_am(cid) * node_c(:,cid)
+      enddo
+
+      if (node_am(id) == ZERO) return
+
+      node_c(:,id) = node_c(:,id) / node_am(id)
+
+      ! Shift the children's moments to this node's center.
+
+      do ch = 1, nch
+         cid = node_child(ch,id)
+         if (node_am(cid) == ZERO) cycle
+
+         s = node_c(:,cid) - node_c(:,id)
+         s2 = s(1)**2 + s(2)**2 + s(3)**2
+         ds = node_d(1,cid) * s(1) + node_d(2,cid) * s(2) + node_d(3,cid) * s(3)
+
+         node_d(:,id) = node_d(:,id) + node_d(:,cid) + node_m(cid) * s
+
+         node_q(1,id) = node_q(1,id) + node_q(1,cid) + SIX * node_d(1,cid) * s(1) - TWO * ds + &
+                        node_m(cid) * (THREE * s(1) * s(1) - s2)
+         node_q(2,id) = node_q(2,id) + node_q(2,cid) + SIX * node_d(2,cid) * s(2) - TWO * ds + &
+                        node_m(cid) * (THREE * s(2) * s(2) - s2)
+         node_q(3,id) = node_q(3,id) + node_q(3,cid) + SIX * node_d(3,cid) * s(3) - TWO * ds + &
+                        node_m(cid) * (THREE * s(3) * s(3) - s2)
+         node_q(4,id) = node_q(4,id) + node_q(4,cid) + THREE * (node_d(1,cid) * s(2) + s(1) * node_d(2,cid)) + &
+                        node_m(cid) * THREE * s(1) * s(2)
+         node_q(5,id) = node_q(5,id) + node_q(5,cid) + THREE * (node_d(1,cid) * s(3) + s(1) * node_d(3,cid)) + &
+                        node_m(cid) * THREE * s(1) * s(3)
+         node_q(6,id) = node_q(6,id) + node_q(6,cid) + THREE * (node_d(2,cid) * s(3) + s(2) * node_d(3,cid)) + &
+                        node_m(cid) * THREE * s(2) * s(3)
+      enddo
+
+    end subroutine build_node
+
+  end subroutine ca_compute_direct_sum_bc_tree
+
+
+
   subroutine ca_put_direct_sum_bc (lo, hi, &
                                    phi, p_lo, p_hi, &
                                    bcXYLo, bcXYHi, &
@@ -423,7 +423,7 @@ contains
   subroutine ca_put_multipole_phi (lo,hi,domlo,domhi,dx, &
                                    phi,p_lo,p_hi, &
                                    lnum,qL0,qLC,qLS,qU0,qUC,qUS, &
-                                   npts,boundary_only) &
+                                   npts,dr,boundary_only) &
                                    bind(C, name="ca_put_multipole_phi")
 
     use prob_params_module, only: problo, center, dim, coord_type
@@ -438,6 +438,7 @@ contains
     real(rt)         :: dx(3)
 
     integer          :: lnum, npts, boundary_only
+    real(rt)         :: dr
     real(rt)         :: qL0(0:lnum,0:npts-1), qLC(0:lnum,0:lnum,0:npts-1), qLS(0:lnum,0:lnum,0:npts-1)
     real(rt)         :: qU0(0:lnum,0:npts-1), qUC(0:lnum,0:lnum,0:npts-1), qUS(0:lnum,0:lnum,0:npts-1)
 
@@ -448,7 +449,7 @@ contains
     integer          :: l, m, n, nlo
     real(rt)         :: x, y, z, r, cosTheta, phiAngle
     real(rt)         :: legPolyArr(0:lnum), assocLegPolyArr(0:lnum,0:lnum)
-    real(rt)         :: r_L, r_U
+    real(rt)         :: r_L, r_U, drInv, f
 
     ! If we're using this to construct boundary values, then only use
     ! the outermost bin.
@@ -459,10 +460,17 @@ contains
        nlo = 0
     endif
 
+    drInv = rmax / dr
+
     if (lnum > lnum_max) then
        call bl_error("Error: ca_compute_multipole_moments: requested more multipole moments than we allocated data for.")
     endif
 
+    if (boundary_only .eq. 0) then
+       call put_multipole_phi_full()
+       return
+    endif
+
     do k = lo(3), hi(3)
        if (k .gt. domhi(3)) then
           z = problo(3) + (dble(k  )     ) * dx(3) - center(3)
@@ -566,15 +574,139 @@ contains
        enddo
     enddo
 
+  contains
+
+    ! Evaluate phi at every zone center in lo:hi, inside the domain or not,
+    ! for gravity_type = MultipoleGrav. Here q(n) holds the moments of all
+    ! the bins up to and including n for qL, and of bin n and all the bins
+    ! beyond it for qU. The mass of the bin a zone sits in is split into
+    ! interior and exterior parts assuming it is spread uniformly in r, that
+    ! is, we linearly interpolate the moments between the bin edges.
+
+    subroutine put_multipole_phi_full()
+
+      real(rt) :: L0, LC, LS, U0, UC, US
+
+      do k = lo(3), hi(3)
+         z = ( problo(3) + (dble(k)+HALF) * dx(3) - center(3) ) / rmax
+
+         do j = lo(2), hi(2)
+            y = ( problo(2) + (dble(j)+HALF) * dx(2) - center(2) ) / rmax
+
+            do i = lo(1), hi(1)
+               x = ( problo(1) + (dble(i)+HALF) * dx(1) - center(1) ) / rmax
+
+               r = sqrt( x**2 + y**2 + z**2 )
+
+               n = min(int(r * drInv), npts-1)
+               f = min(r * drInv - dble(n), ONE)
+
+               phi(i,j,k) = ZERO
+
+               ! At the center only the monopole of the exterior mass survives.
+
+               if ( r < 1.0e-12_rt ) then
+                  phi(i,j,k) = -Gconst * qU0(0,0) * rmax**2
+                  cycle
+               endif
+
+               cosTheta = z / r
+               phiAngle = atan2(y,x)
+
+               call fill_legendre_arrays(legPolyArr, assocLegPolyArr, cosTheta, lnum)
+
+               legPolyArr = legPolyArr * rmax**3
+               assocLegPolyArr = assocLegPolyArr * rmax**3
+
+               do l = 0, lnum
+
+                  r_L = r**dble( l  )
+                  r_U = r**dble(-l-1)
+
+                  L0 = f * qL0(l,n)
+                  if (n > 0) L0 = L0 + (ONE - f) * qL0(l,n-1)
+
+                  U0 = (ONE - f) * qU0(l,n)
+                  if (n < npts-1) U0 = U0 + f * qU0(l,n+1)
+
+                  phi(i,j,k) = phi(i,j,k) + legPolyArr(l) * (L0 * r_U + U0 * r_L)
+
+                  do m = 1, l
+
+                     LC = f * qLC(l,m,n)
+                     LS = f * qLS(l,m,n)
+                     if (n > 0) then
+                        LC = LC + (ONE - f) * qLC(l,m,n-1)
+                        LS = LS + (ONE - f) * qLS(l,m,n-1)
+                     endif
+
+                     UC = (ONE - f) * qUC(l,m,n)
+                     US = (ONE - f) * qUS(l,m,n)
+                     if (n < npts-1) then
+                        UC = UC + f * qUC(l,m,n+1)
+                        US = US + f * qUS(l,m,n+1)
+                     endif
+
+                     phi(i,j,k) = phi(i,j,k) + assocLegPolyArr(l,m) * &
+                                  ( (LC * cos(m * phiAngle) + LS * sin(m * phiAngle)) * r_U + &
+                                    (UC * cos(m * phiAngle) + US * sin(m * phiAngle)) * r_L )
+
+                  enddo
+
+               enddo
+
+               phi(i,j,k) = -Gconst * phi(i,j,k) / rmax
+
+            enddo
+         enddo
+      enddo
+
+    end subroutine put_multipole_phi_full
+
   end subroutine ca_put_multipole_phi
 
 
 
+  ! Compute g = -grad phi at zone centers by centered differences; phi
+  ! must be valid in one ghost zone around lo:hi.
+
+  subroutine ca_multipole_grav(lo,hi,dx,phi,p_lo,p_hi,grav,g_lo,g_hi) &
+                               bind(C, name="ca_multipole_grav")
+
+    use bl_constants_module
+
+    use bl_fort_module, only : rt => c_real
+    implicit none
+
+    integer          :: lo(3), hi(3)
+    real(rt)         :: dx(3)
+
+    integer          :: p_lo(3), p_hi(3)
+    integer          :: g_lo(3), g_hi(3)
+    real(rt)         :: phi(p_lo(1):p_hi(1),p_lo(2):p_hi(2),p_lo(3):p_hi(3))
+    real(rt)         :: grav(g_lo(1):g_hi(1),g_lo(2):g_hi(2),g_lo(3):g_hi(3),3)
+
+    integer          :: i, j, k
+
+    do k = lo(3), hi(3)
+       do j = lo(2), hi(2)
+          do i = lo(1), hi(1)
+             grav(i,j,k,1) = -( phi(i+1,j,k) - phi(i-1,j,k) ) / (TWO * dx(1))
+             grav(i,j,k,2) = -( phi(i,j+1,k) - phi(i,j-1,k) ) / (TWO * dx(2))
+             grav(i,j,k,3) = -( phi(i,j,k+1) - phi(i,j,k-1) ) / (TWO * dx(3))
+          enddo
+       enddo
+    enddo
+
+  end subroutine ca_multipole_grav
+
+
+
   subroutine ca_compute_multipole_moments (lo,hi,domlo,domhi, &
                                            dx,rho,r_lo,r_hi, &
                                            vol,v_lo,v_hi, &
                                            lnum,qL0,qLC,qLS,qU0,qUC,qUS, &
-                                           npts,boundary_only) &
+                                           npts,dr,boundary_only) &
                                            bind(C, name="ca_compute_multipole_moments")
 
     use prob_params_module, only: problo, center, probhi, dim, coord_type
@@ -587,6 +719,7 @@ contains
     integer          :: domlo(3),domhi(3)
     real(rt)         :: dx(3)
     integer          :: boundary_only, npts, lnum
+    real(rt)         :: dr
 
     real(rt)         :: qL0(0:lnum,0:npts-1), qLC(0:lnum,0:lnum,0:npts-1), qLS(0:lnum,0:lnum,0:npts-1)
     real(rt)         :: qU0(0:lnum,0:npts-1), qUC(0:lnum,0:lnum,0:npts-1), qUS(0:lnum,0:lnum,0:npts-1)
@@ -602,7 +735,9 @@ contains
     real(rt)         :: x, y, z, r, drInv, cosTheta, phiAngle
 
     ! If we're using this to construct boundary values, then only fill
-    ! the outermost bin.
+    ! the outermost bin. Otherwise we fill each zone's own radial bin
+    ! (of width dr) with both its interior and exterior moments, and
+    ! the caller sums them over the bins.
 
     if (boundary_only .eq. 1) then
        nlo = npts-1
@@ -612,7 +747,7 @@ contains
 
     ! Note that we don't currently support dx != dy != dz, so this is acceptable.
 
-    drInv = rmax / dx(1)
+    drInv = rmax / dr
 
     ! Sanity check
 
@@ -633,7 +768,11 @@ contains
 
              if (dim .eq. 3) then
                 index = int(r * drInv)
-                cosTheta = z / r
+                if (r > ZERO) then
+                   cosTheta = z / r
+                else
+                   cosTheta = ONE
+                endif
                 phiAngle = atan2(y, x)
              else if (dim .eq. 2 .and. coord_type .eq. 1) then
                 index = nlo ! We only do the boundary potential in 2D.
@@ -643,19 +782,40 @@ contains
 
              ! Now, compute the multipole moments.
 
-             call multipole_add(cosTheta, phiAngle, r, rho(i,j,k), vol(i,j,k) / rmax**3, &
-                                qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, .true.)
+             if (boundary_only .eq. 1) then
+
+                call multipole_add(cosTheta, phiAngle, r, rho(i,j,k), vol(i,j,k) / rmax**3, &
+                                   qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, .true.)
+
+             else
+
+                call multipole_add(cosTheta, phiAngle, r, rho(i,j,k), vol(i,j,k) / rmax**3, &
+                                   qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, .true., drInv)
+
+             endif
 
              ! Now add in contributions if we have any symmetric boundaries in 3D.
              ! The symmetric boundary in 2D axisymmetric is handled separately.
 
              if ( doSymmetricAdd ) then
 
-                call multipole_symmetric_add(doSymmetricAddLo, doSymmetricAddHi, &
-                                             x, y, z, problo, probhi, &
-                                             rho(i,j,k), vol(i,j,k) / rmax**3, &
-                                             qL0, qLC, qLS, qU0, qUC, qUS, &
-                                             lnum, npts, nlo, index)
+                if (boundary_only .eq. 1) then
+
+                   call multipole_symmetric_add(doSymmetricAddLo, doSymmetricAddHi, &
+                                                x, y, z, problo, probhi, &
+                                                rho(i,j,k), vol(i,j,k) / rmax**3, &
+                                                qL0, qLC, qLS, qU0, qUC, qUS, &
+                                                lnum, npts, nlo, index)
+
+                else
+
+                   call multipole_symmetric_add(doSymmetricAddLo, doSymmetricAddHi, &
+                                                x, y, z, problo, probhi, &
+                                                rho(i,j,k), vol(i,j,k) / rmax**3, &
+                                                qL0, qLC, qLS, qU0, qUC, qUS, &
+                                                lnum, npts, nlo, index, drInv)
+
+                endif
 
              endif
 
@@ -775,8 +935,8 @@ contains
   subroutine multipole_symmetric_add(doSymmetricAddLo, doSymmetricAddHi, &
                                      x, y, z, problo, probhi, &
                                      rho, vol, &
-                                     qU0, qUC, qUS, qL0, qLC, qLS, &
-                                     lnum, npts, nlo, index)
+                                     qL0, qLC, qLS, qU0, qUC, qUS, &
+                                     lnum, npts, nlo, index, drInv)
 
     use prob_params_module, only: center
     use bl_constants_module
@@ -791,6 +951,8 @@ contains
 
     logical,          intent(in) :: doSymmetricAddLo(3), doSymmetricAddHi(3)
 
+    real(rt)        , optional, intent(in) :: drInv
+
     real(rt)        , intent(inout) :: qL0(0:lnum,0:npts-1)
     real(rt)        , intent(inout) :: qLC(0:lnum,0:lnum,0:npts-1), qLS(0:lnum,0:lnum,0:npts-1)
 
@@ -815,7 +977,8 @@ contains
        phiAngle = atan2(y, xLo)
        cosTheta = z / r
 
-       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        if ( doSymmetricAddLo(2) ) then
 
@@ -823,7 +986,8 @@ contains
           phiAngle = atan2(yLo, xLo)
           cosTheta = z / r
 
-          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        endif
 
@@ -833,7 +997,8 @@ contains
           phiAngle = atan2(y, xLo)
           cosTheta = zLo / r
 
-          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        endif
 
@@ -843,7 +1008,8 @@ contains
           phiAngle = atan2(yLo, xLo)
           cosTheta = zLo / r
 
-          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        endif
 
@@ -855,7 +1021,8 @@ contains
        phiAngle = atan2(yLo, x)
        cosTheta = z / r
 
-       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        if ( doSymmetricAddLo(3) ) then
 
@@ -863,7 +1030,8 @@ contains
           phiAngle = atan2(yLo, x)
           cosTheta = zLo / r
 
-          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+          call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
        endif
 
@@ -875,7 +1043,8 @@ contains
        phiAngle = atan2(y, x)
        cosTheta = zLo / r
 
-       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index)
+       call multipole_add(cosTheta, phiAngle, r, rho, vol, qL0, qLC, qLS, qU0, qUC, qUS, lnum, npts, nlo, index, &
+                          drInv = drInv)
 
     endif
 
@@ -885,9 +1054,9 @@ contains
 
   subroutine multipole_add(cosTheta, phiAngle, r, rho, vol, &
                            qL0, qLC, qLS, qU0, qUC, qUS, &
-                           lnum, npts, nlo, index, do_parity)
+                           lnum, npts, nlo, index, do_parity, drInv)
 
-    use bl_constants_module, only: ONE
+    use bl_constants_module, only: ZERO, ONE
 
     use bl_fort_module, only : rt => c_real
     implicit none
@@ -900,7 +1069,12 @@ contains
 
     logical, optional, intent(in)   :: do_parity
 
-    integer :: l, m, n
+    ! If drInv is present, add both moments to the zone's own bin, int(r * drInv),
+    ! rather than to all the bins from nlo on.
+
+    real(rt)        , optional, intent(in) :: drInv
+
+    integer :: l, m, n, bin
 
     real(rt)         :: legPolyArr(0:lnum), assocLegPolyArr(0:lnum,0:lnum)
 
@@ -924,6 +1098,43 @@ contains
        endif
     endif
 
+    if (present(drInv)) then
+
+       bin = min(int(r * drInv), npts-1)
+
+       do l = 0, lnum
+
+          rho_r_L = rho * (r ** dble( l  ))
+
+          qL0(l,bin) = qL0(l,bin) + legPolyArr(l) * rho_r_L * vol * volumeFactor * p0(l)
+
+          do m = 1, l
+             qLC(l,m,bin) = qLC(l,m,bin) + assocLegPolyArr(l,m) * cos(m * phiAngle) * rho_r_L * vol * pCS(l,m)
+             qLS(l,m,bin) = qLS(l,m,bin) + assocLegPolyArr(l,m) * sin(m * phiAngle) * rho_r_L * vol * pCS(l,m)
+          enddo
+
+          ! The exterior moments are singular for a zone centered on the origin;
+          ! such a zone only contributes to the interior moments.
+
+          if (r > ZERO) then
+
+             rho_r_U = rho * (r ** dble(-l-1))
+
+             qU0(l,bin) = qU0(l,bin) + legPolyArr(l) * rho_r_U * vol * volumeFactor * p0(l)
+
+             do m = 1, l
+                qUC(l,m,bin) = qUC(l,m,bin) + assocLegPolyArr(l,m) * cos(m * phiAngle) * rho_r_U * vol * pCS(l,m)
+                qUS(l,m,bin) = qUS(l,m,bin) + assocLegPolyArr(l,m) * sin(m * phiAngle) * rho_r_U * vol * pCS(l,m)
+             enddo
+
+          endif
+
+       enddo
+
+       return
+
+    endif
+
     do n = nlo, npts-1
 
        do l = 0, lnum
@@ -38,6 +38,98 @@ contains
 
 
 
+  ! Compute, in one sweep, all of the integrals reported by
+  ! sum_integrated_quantities. The sums are accumulated into:
+  !
+  !   sums(1:ncomps)          : volume-weighted sums of the state components comps
+  !   sums(ncomps+1:ncomps+3) : angular momentum (about the origin)
+  !   sums(ncomps+4)          : kinetic energy
+  !   sums(ncomps+5)          : rho * phi (if do_phi == 1)
+  !   sums(ncomps+6:ncomps+8) : rho * (x - center), as in ca_sumlocmass
+  !
+  ! If use_mask == 1 every zone is weighted by mask (zero under fine grids).
+
+  subroutine ca_sum_integrated(lo,hi,u,u_lo,u_hi,phi,p_lo,p_hi,mask,m_lo,m_hi, &
+                               vol,v_lo,v_hi,dx,use_mask,do_phi, &
+                               comps,ncomps,sums,nsums) bind(C, name="ca_sum_integrated")
+
+    use meth_params_module, only: NVAR, URHO, UMX, UMZ
+    use prob_params_module, only: problo, center, probhi, dim, physbc_lo, physbc_hi, Symmetry
+    use math_module, only: cross_product
+    use bl_constants_module
+
+    use bl_fort_module, only : rt => c_real
+    implicit none
+
+    integer          :: lo(3), hi(3)
+    integer          :: u_lo(3), u_hi(3)
+    integer          :: p_lo(3), p_hi(3)
+    integer          :: m_lo(3), m_hi(3)
+    integer          :: v_lo(3), v_hi(3)
+    integer          :: use_mask, do_phi, ncomps, nsums
+    integer          :: comps(ncomps)
+    real(rt)         :: dx(3)
+    real(rt)         :: u(u_lo(1):u_hi(1),u_lo(2):u_hi(2),u_lo(3):u_hi(3),NVAR)
+    real(rt)         :: phi(p_lo(1):p_hi(1),p_lo(2):p_hi(2),p_lo(3):p_hi(3))
+    real(rt)         :: mask(m_lo(1):m_hi(1),m_lo(2):m_hi(2),m_lo(3):m_hi(3))
+    real(rt)         :: vol(v_lo(1):v_hi(1),v_lo(2):v_hi(2),v_lo(3):v_hi(3))
+    real(rt)         :: sums(nsums)
+
+    integer          :: i, j, k, n, idir
+    real(rt)         :: loc(3), rel(3), mom(3), dV, rho
+    real(rt)         :: symlo, symhi
+
+    loc = ZERO
+    rel = ZERO
+
+    do k = lo(3), hi(3)
+       if (dim .eq. 3) loc(3) = problo(3) + (dble(k)+HALF) * dx(3)
+       do j = lo(2), hi(2)
+          if (dim .ge. 2) loc(2) = problo(2) + (dble(j)+HALF) * dx(2)
+          do i = lo(1), hi(1)
+             loc(1) = problo(1) + (dble(i)+HALF) * dx(1)
+
+             dV = vol(i,j,k)
+             if (use_mask .eq. 1) dV = dV * mask(i,j,k)
+
+             do n = 1, ncomps
+                sums(n) = sums(n) + dV * u(i,j,k,comps(n)+1)
+             enddo
+
+             rho = u(i,j,k,URHO)
+             mom = u(i,j,k,UMX:UMZ)
+
+             sums(ncomps+1:ncomps+3) = sums(ncomps+1:ncomps+3) + dV * cross_product(loc, mom)
+
+             sums(ncomps+4) = sums(ncomps+4) + dV * HALF / rho * sum(mom**2)
+
+             if (do_phi .eq. 1) then
+                sums(ncomps+5) = sums(ncomps+5) + dV * rho * phi(i,j,k)
+             endif
+
+             do idir = 1, dim
+                rel(idir) = loc(idir) - center(idir)
+                symlo = ZERO
+                symhi = ZERO
+                if (physbc_lo(idir) .eq. Symmetry) then
+                   symlo = problo(idir) - rel(idir)
+                endif
+                if (physbc_hi(idir) .eq. Symmetry) then
+                   symhi = rel(idir) - probhi(idir)
+                endif
+                rel(idir) = rel(idir) + symlo + symhi
+             enddo
+
+             sums(ncomps+6:ncomps+8) = sums(ncomps+6:ncomps+8) + dV * rho * rel
+
+          enddo
+       enddo
+    enddo
+
+  end subroutine ca_sum_integrated
+
+
+
   subroutine ca_sumsquared(lo,hi,rho,r_lo,r_hi,dx,&
                            vol,v_lo,v_hi,mass) bind(C, name="ca_sumsquared")
 
@@ -193,6 +193,10 @@ main (int   argc,
 
     }
 
+    // Make sure any plotfile data written in the background is on disk.
+
+    Castro::finishAsyncIO();
+
     time(&time_type);
 
     time_pointer = gmtime(&time_type);
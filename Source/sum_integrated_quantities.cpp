@@ -13,8 +13,6 @@ Castro::sum_integrated_quantities ()
 
     if (verbose <= 0) return;
 
-    bool local_flag = true;
-
     int finest_level = parent->finestLevel();
     Real time        = state[State_Type].curTime();
     Real mass        = 0.0;
@@ -36,101 +34,69 @@ Castro::sum_integrated_quantities ()
     int datwidth     = 14;
     int datprecision = 6;
 
-    for (int lev = 0; lev <= finest_level; lev++)
-    {
-        Castro& ca_lev = getLevel(lev);
-
-        mass   += ca_lev.volWgtSum("density", time, local_flag);
-        mom[0] += ca_lev.volWgtSum("xmom", time, local_flag);
-	mom[1] += ca_lev.volWgtSum("ymom", time, local_flag);
-	mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
-
-	ang_mom[0] += ca_lev.volWgtSum("angular_momentum_x", time, local_flag);
-	ang_mom[1] += ca_lev.volWgtSum("angular_momentum_y", time, local_flag);
-	ang_mom[2] += ca_lev.volWgtSum("angular_momentum_z", time, local_flag);
+    // All of the integrals are computed in a single sweep over each
+    // level and reduced together. First come the state components
+    // that are simply integrated over the volume.
 
+    Array<int> comps;
+    comps.push_back(Density);
+    comps.push_back(Xmom);
+    comps.push_back(Xmom+1);
+    comps.push_back(Xmom+2);
 #ifdef HYBRID_MOMENTUM
-	hyb_mom[0] += ca_lev.volWgtSum("rmom", time, local_flag);
-	hyb_mom[1] += ca_lev.volWgtSum("lmom", time, local_flag);
-	hyb_mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
+    comps.push_back(Rmom);
+    comps.push_back(Lmom);
 #endif
-	
-	if (show_center_of_mass) {
-	   com[0] += ca_lev.locWgtSum("density", time, 0, local_flag);
-	   com[1] += ca_lev.locWgtSum("density", time, 1, local_flag);
-	   com[2] += ca_lev.locWgtSum("density", time, 2, local_flag);
-	}
+    comps.push_back(Eint);
+    comps.push_back(Eden);
 
-       rho_e += ca_lev.volWgtSum("rho_e", time, local_flag);
-       rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
-       rho_E += ca_lev.volWgtSum("rho_E", time, local_flag);
-#ifdef SELF_GRAVITY
-       rho_phi += ca_lev.volProductSum("density", "phiGrav", time, local_flag);
-#endif
+    const int nsums = comps.size() + 8;
 
-    }
- 
-    if (verbose > 0)
-    {
+    Array<Real> sums(nsums, 0.0);
 
-#ifdef HYBRID_MOMENTUM
-#ifdef SELF_GRAVITY
-       const int nfoo = 14;
-#else
-       const int nfoo = 13;
-#endif
-#else
-#ifdef SELF_GRAVITY
-       const int nfoo = 11;
-#else
-       const int nfoo = 10;
-#endif
-#endif
+    for (int lev = 0; lev <= finest_level; lev++)
+        getLevel(lev).sumIntegrated(comps, sums);
 
-	Real foo[nfoo] = {mass, mom[0], mom[1], mom[2], ang_mom[0], ang_mom[1], ang_mom[2],
-#ifdef HYBRID_MOMENTUM
-			  hyb_mom[0], hyb_mom[1], hyb_mom[2],
-#endif
-#ifdef SELF_GRAVITY
-			  rho_e, rho_K, rho_E, rho_phi};
-#else
-			  rho_e, rho_K, rho_E};
-#endif
+    if (verbose > 0)
+    {
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
 
-	ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
-
-	if (show_center_of_mass)
-	    ParallelDescriptor::ReduceRealSum(com, 3, ParallelDescriptor::IOProcessorNumber());
+	ParallelDescriptor::ReduceRealSum(sums.dataPtr(), nsums, ParallelDescriptor::IOProcessorNumber());
 
 	if (ParallelDescriptor::IOProcessor()) {
 
 	    int i = 0;
-	    mass       = foo[i++];
-	    mom[0]     = foo[i++];
-            mom[1]     = foo[i++];
-            mom[2]     = foo[i++];
-	    ang_mom[0] = foo[i++];
-	    ang_mom[1] = foo[i++];
-	    ang_mom[2] = foo[i++];
+	    mass       = sums[i++];
+	    mom[0]     = sums[i++];
+            mom[1]     = sums[i++];
+            mom[2]     = sums[i++];
 #ifdef HYBRID_MOMENTUM
-	    hyb_mom[0] = foo[i++];
-	    hyb_mom[1] = foo[i++];
-	    hyb_mom[2] = foo[i++];
-#endif
-	    rho_e      = foo[i++];
-	    rho_K      = foo[i++];
-            rho_E      = foo[i++];
+	    hyb_mom[0] = sums[i++];
+	    hyb_mom[1] = sums[i++];
+	    hyb_mom[2] = mom[2];
+#endif
+	    rho_e      = sums[i++];
+            rho_E      = sums[i++];
+	    ang_mom[0] = sums[i++];
+	    ang_mom[1] = sums[i++];
+	    ang_mom[2] = sums[i++];
+	    rho_K      = sums[i++];
 #ifdef SELF_GRAVITY
-	    rho_phi    = foo[i++];
+	    rho_phi    = sums[i];
+#endif
+	    i++;
+	    com[0]     = sums[i++];
+	    com[1]     = sums[i++];
+	    com[2]     = sums[i++];
 
+#ifdef SELF_GRAVITY
 	    // Total energy is -1/2 * rho * phi + rho * E for self-gravity,
 	    // and -rho * phi + rho * E for externally-supplied gravity.
 	    std::string gravity_type = gravity->get_gravity_type();
-	    if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav")
+	    if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav" || gravity_type == "MultipoleGrav")
 	      total_energy = -0.5 * rho_phi + rho_E;
 	    else
 	      total_energy = -rho_phi + rho_E;
@@ -578,3 +578,57 @@ Castro::locSquaredSum (const std::string& name,
     return sum;
 }
 
+void
+Castro::sumIntegrated (const Array<int>& comps, Array<Real>& sums)
+{
+    BL_PROFILE("Castro::sumIntegrated()");
+
+    const Real* dx    = geom.CellSize();
+    const int  ncomps = comps.size();
+    const int  nsums  = sums.size();
+
+    BL_ASSERT(nsums == ncomps + 8);
+
+    const MultiFab& S_new = get_new_data(State_Type);
+
+    const int use_mask = (level < parent->finestLevel()) ? 1 : 0;
+
+    // The mask and phi are only touched if use_mask and do_phi are
+    // set, so we hand the volume to Fortran in their place otherwise.
+
+    const MultiFab& mask = use_mask ? getLevel(level+1).build_fine_mask() : volume;
+
+#ifdef SELF_GRAVITY
+    const int do_phi = 1;
+    const MultiFab& phi = get_new_data(PhiGrav_Type);
+#else
+    const int do_phi = 0;
+    const MultiFab& phi = volume;
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+	Array<Real> priv_sums(nsums, 0.0);
+
+	for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
+	{
+	    const Box& box = mfi.tilebox();
+
+	    ca_sum_integrated(ARLIM_3D(box.loVect()), ARLIM_3D(box.hiVect()),
+			      BL_TO_FORTRAN_3D(S_new[mfi]),
+			      BL_TO_FORTRAN_3D(phi[mfi]),
+			      BL_TO_FORTRAN_3D(mask[mfi]),
+			      BL_TO_FORTRAN_3D(volume[mfi]),
+			      ZFILL(dx), use_mask, do_phi,
+			      comps.dataPtr(), ncomps, priv_sums.dataPtr(), nsums);
+	}
+
+#ifdef _OPENMP
+#pragma omp critical (sum_integrated)
+#endif
+	for (int n = 0; n < nsums; ++n)
+	    sums[n] += priv_sums[n];
+    }
+}
@@ -0,0 +1,172 @@
+
+// This reads a plotfile written with castro.plot_compression = 1
+// and converts it, in place, to a standard plotfile.
+// ---------------------------------------------------------------
+#include <winstd.H>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <iterator>
+
+#include "REAL.H"
+#include "Box.H"
+#include "BoxArray.H"
+#include "FArrayBox.H"
+#include "ParmParse.H"
+#include "ParallelDescriptor.H"
+#include "Utility.H"
+
+#include "Castro_codec.H"
+
+using std::cout;
+using std::endl;
+
+std::string PlotFile;
+bool verbose(true);
+
+// ---------------------------------------------------------------
+static void ScanArguments() {
+    ParmParse pp;
+
+    pp.get("plotfile", PlotFile);
+
+    if(pp.contains("verbose")) {
+      pp.get("verbose", verbose);
+    }
+}
+
+// ---------------------------------------------------------------
+static void PrintUsage (char *progName) {
+    cout << "Usage: " << progName << " plotfile=filename "
+         << "[verbose=trueorfalse]" << endl;
+    exit(1);
+}
+
+// ---------------------------------------------------------------
+// Convert the MultiFab whose header is mf_name + "_H".  Returns
+// false if it was not compressed.
+// ---------------------------------------------------------------
+static bool UncompressMultiFab(const std::string& mf_name) {
+
+    const std::string header_name = mf_name + "_H";
+
+    std::ifstream is(header_name.c_str());
+    if ( ! is.good()) {
+      BoxLib::FileOpenFailed(header_name);
+    }
+
+    int vers, how, ncomp, ngrow, nfabs;
+    BoxArray ba;
+
+    is >> vers >> how >> ncomp >> ngrow;
+    ba.readFrom(is);
+    is >> nfabs;
+
+    std::vector<std::string> fab_names(nfabs);
+    std::vector<long> fab_offsets(nfabs);
+
+    for (int i = 0; i < nfabs; ++i) {
+      std::string tag;
+      is >> tag >> fab_names[i] >> fab_offsets[i];
+      if (tag != "FabOnDisk:") {
+        BoxLib::Abort("UncompressMultiFab: bad header " + header_name);
+      }
+    }
+
+    // The min/max data is copied over as is.
+    std::string rest((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    is.close();
+
+    if (nfabs == 0 || fab_names[0].find("_Z_") == std::string::npos) {
+      return false;
+    }
+
+    const std::string dir_name = mf_name.substr(0, mf_name.rfind('/') + 1);
+
+    for (int i = 0; i < nfabs; ++i) {
+      const std::string z_name = dir_name + fab_names[i];
+
+      std::ifstream zfile(z_name.c_str(), std::ios::in | std::ios::binary);
+      if ( ! zfile.good()) {
+        BoxLib::FileOpenFailed(z_name);
+      }
+
+      FArrayBox fab;
+      CastroCodec::readFab(zfile, fab);
+      zfile.close();
+
+      fab_names[i].replace(fab_names[i].find("_Z_"), 3, "_D_");
+
+      const std::string d_name = dir_name + fab_names[i];
+
+      std::ofstream dfile(d_name.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+      if ( ! dfile.good()) {
+        BoxLib::FileOpenFailed(d_name);
+      }
+      fab.writeOn(dfile);
+      dfile.close();
+
+      std::remove(z_name.c_str());
+    }
+
+    std::ofstream os(header_name.c_str(), std::ios::out | std::ios::trunc);
+    if ( ! os.good()) {
+      BoxLib::FileOpenFailed(header_name);
+    }
+
+    os << vers << '\n';
+    os << how << '\n';
+    os << ncomp << '\n';
+    os << ngrow << '\n';
+    ba.writeOn(os);
+    os << '\n';
+    os << nfabs << '\n';
+    for (int i = 0; i < nfabs; ++i) {
+      os << "FabOnDisk: " << fab_names[i] << ' ' << fab_offsets[i] << '\n';
+    }
+    os << rest;
+    os.close();
+
+    return true;
+}
+
+
+// ---------------------------------------------------------------
+int main(int argc, char *argv[]) {
+    BoxLib::Initialize(argc,argv);
+
+    if(argc < 2) {
+      PrintUsage(argv[0]);
+    }
+
+    if (ParallelDescriptor::NProcs() > 1) {
+      BoxLib::Abort("Uncompress runs on a single processor");
+    }
+
+    ScanArguments();
+
+    // Each level of a Castro plotfile is in Level_<lev>/Cell.
+    for (int lev = 0; ; ++lev) {
+      char buf[64];
+      sprintf(buf, "/Level_%d/Cell", lev);
+      const std::string mf_name = PlotFile + buf;
+
+      if ( ! BoxLib::FileExists(mf_name + "_H")) {
+        break;
+      }
+
+      const bool converted = UncompressMultiFab(mf_name);
+
+      if(verbose) {
+        cout << "Level " << lev << (converted ? ": uncompressed" : ": not compressed") << endl;
+      }
+    }
+
+    BoxLib::Finalize();
+}
+// ---------------------------------------------------------------
+// ---------------------------------------------------------------